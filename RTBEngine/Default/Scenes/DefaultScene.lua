@@ -35,6 +35,8 @@ function CreateScene()
                         intensity = 1.0,
                         castShadows = true,
                         shadowMapResolution = 2048,
+                        shadowCascadeCount = 4,
+                        shadowDistance = 100.0,
                         shadowBias = 0.005
                     }
 
@@ -156,6 +158,7 @@ function CreateScene()
                         type = "MeshRenderer",
                         mesh = "Default/Models/cube.obj",
                         shader = "basic",
+                        isStatic = true
                     }
                 }
             },
@@ -168,7 +171,8 @@ function CreateScene()
                     {
                         type = "MeshRenderer",
                         mesh = "Default/Models/cube.obj",
-                        shader = "basic"
+                        shader = "basic",
+                        isStatic = true
                     }
                 }
             },
@@ -4,7 +4,7 @@ in vec3 vColor;
 in vec2 vTexCoords;
 in vec3 vNormal;
 in vec3 vFragPos;
-in vec4 vFragPosLightSpace;
+in float vViewDepth;
 
 out vec4 FragColor;
 
@@ -13,59 +13,68 @@ uniform sampler2D uTexture;
 uniform bool uHasTexture;
 uniform vec4 uColor;
 uniform vec3 uDiffuseColor;
-uniform vec3 uViewPos;
 
-// Directional Light
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewPosition;
+};
+
+// Light data is packed into vec4s to match Rendering::LightUniforms (std140)
 struct DirectionalLight {
-    vec3 direction;
-    vec3 color;
-    float intensity;
+    vec4 direction;             // xyz
+    vec4 colorIntensity;        // rgb, intensity
+};
+
+layout(std140, binding = 1) uniform LightBlock {
+    DirectionalLight dirLight;
 };
-uniform DirectionalLight dirLight;
-
-// Point Lights
-#define MAX_POINT_LIGHTS 8
-struct PointLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-    float constant;
-    float linear;
-    float quadratic;
-    float range;
+
+// Point and spot lights, packed to match Rendering::LocalLightData (std430)
+struct LocalLight {
+    vec4 positionRange;         // xyz, range
+    vec4 colorIntensity;        // rgb, intensity
+    vec4 directionInnerCutOff;  // xyz, cos(inner)
+    vec4 attenuationOuterCutOff;// constant, linear, quadratic, cos(outer); < -1 for point lights
 };
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform int numPointLights;
-
-// Spot Lights
-#define MAX_SPOT_LIGHTS 8
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    vec3 color;
-    float intensity;
-    float innerCutOff;
-    float outerCutOff;
-    float constant;
-    float linear;
-    float quadratic;
-    float range;
+
+// Froxel grid built by Rendering::LightClusters
+layout(std140, binding = 3) uniform ClusterBlock {
+    uvec4 uClusterGrid;         // xyz: clusters per axis, w: local light count
+    vec4 uClusterParams;        // x, y: tile size in pixels, z: slice scale, w: slice bias
 };
-uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
-uniform int numSpotLights;
 
-uniform sampler2D uShadowMap;
-uniform bool uHasShadows;
-uniform float uShadowBias;
+layout(std430, binding = 4) readonly buffer LocalLights {
+    LocalLight localLights[];
+};
+
+layout(std430, binding = 5) readonly buffer ClusterRanges {
+    uvec2 clusterRanges[];      // offset, count into clusterLightIndices
+};
+
+layout(std430, binding = 6) readonly buffer ClusterLightIndices {
+    uint clusterLightIndices[];
+};
+
+#define MAX_SHADOW_CASCADES 4
+layout(std140, binding = 2) uniform ShadowBlock {
+    mat4 uLightSpaceMatrices[MAX_SHADOW_CASCADES];
+    vec4 uCascadeSplits;        // view-space far distance of each cascade
+    vec4 uShadowParams;         // x: has shadows, y: bias, z: cascade count
+};
+
+// One layer per cascade
+layout(binding = 1) uniform sampler2DArray uShadowMap;
 
 vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-float ShadowCalculation(vec4 fragPosLightSpace, float bias);
+vec3 CalcLocalLight(LocalLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+uint GetClusterIndex(vec2 fragCoord, float viewDepth);
+float ShadowCalculation(vec3 fragPos, float viewDepth, float bias);
 
 void main() {
     vec3 norm = normalize(vNormal);
-    vec3 viewDir = normalize(uViewPos - vFragPos);
+    vec3 viewDir = normalize(uViewPosition.xyz - vFragPos);
 
     // Ambient - use a neutral gray, not tinted by light color
     vec3 ambient = vec3(0.1);
@@ -73,26 +82,23 @@ void main() {
     // Directional light contribution
     vec3 dirLightContrib = CalcDirectionalLight(dirLight, norm, viewDir);
 
-    // Point lights
-    vec3 pointLightContrib = vec3(0.0);
-    for (int i = 0; i < numPointLights && i < MAX_POINT_LIGHTS; i++) {
-        pointLightContrib += CalcPointLight(pointLights[i], norm, vFragPos, viewDir);
-    }
-
-    // Spot lights
-    vec3 spotLightContrib = vec3(0.0);
-    for (int i = 0; i < numSpotLights && i < MAX_SPOT_LIGHTS; i++) {
-        spotLightContrib += CalcSpotLight(spotLights[i], norm, vFragPos, viewDir);
+    // Point and spot lights touching this fragment's cluster
+    vec3 localLightContrib = vec3(0.0);
+    if (uClusterGrid.w > 0u) {
+        uvec2 range = clusterRanges[GetClusterIndex(gl_FragCoord.xy, vViewDepth)];
+        for (uint i = 0u; i < range.y; i++) {
+            localLightContrib += CalcLocalLight(localLights[clusterLightIndices[range.x + i]], norm, vFragPos, viewDir);
+        }
     }
 
     // Apply shadow only to directional light (which casts shadows)
     float shadow = 0.0;
-    if (uHasShadows) {
-        shadow = ShadowCalculation(vFragPosLightSpace, uShadowBias);
+    if (uShadowParams.x > 0.5) {
+        shadow = ShadowCalculation(vFragPos, vViewDepth, uShadowParams.y);
     }
 
     // Combine lighting: ambient + shadowed directional + unshadowed point/spot
-    vec3 result = ambient + (1.0 - shadow) * dirLightContrib + pointLightContrib + spotLightContrib;
+    vec3 result = ambient + (1.0 - shadow) * dirLightContrib + localLightContrib;
 
     vec4 texColor = uHasTexture ? texture(uTexture, vTexCoords) : vec4(1.0);
     FragColor = vec4(result * uDiffuseColor, 1.0) * texColor * uColor;
@@ -100,74 +106,71 @@ void main() {
 
 
 vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir) {
-    vec3 lightDir = normalize(-light.direction);
+    vec3 lightColor = light.colorIntensity.rgb * light.colorIntensity.w;
+    if (dot(light.direction.xyz, light.direction.xyz) == 0.0) {
+        return vec3(0.0);
+    }
+    vec3 lightDir = normalize(-light.direction.xyz);
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = diff * light.color * light.intensity;
+    vec3 diffuse = diff * lightColor;
     
     // Specular
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-    vec3 specular = spec * light.color * light.intensity * 0.5;
+    vec3 specular = spec * lightColor * 0.5;
     
     return diffuse + specular;
 }
 
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
-    float distance = length(light.position - fragPos);
-    
-    // Skip if out of range
-    if (distance > light.range) {
-        return vec3(0.0);
-    }
-    
-    // Attenuation
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * distance * distance);
-    
-    // Diffuse
-    float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = diff * light.color * light.intensity;
-    
-    // Specular
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-    vec3 specular = spec * light.color * light.intensity * 0.5;
-    
-    return (diffuse + specular) * attenuation;
+uint GetClusterIndex(vec2 fragCoord, float viewDepth) {
+    // Slices are exponential in view depth: slice = log(depth) * scale - bias
+    uvec3 cluster;
+    cluster.xy = uvec2(fragCoord / uClusterParams.xy);
+    cluster.z = uint(max(log(viewDepth) * uClusterParams.z - uClusterParams.w, 0.0));
+    cluster = min(cluster, uClusterGrid.xyz - 1u);
+    return cluster.x + cluster.y * uClusterGrid.x + cluster.z * uClusterGrid.x * uClusterGrid.y;
 }
 
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
-    vec3 lightDir = normalize(light.position - fragPos);
-    float distance = length(light.position - fragPos);
+vec3 CalcLocalLight(LocalLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
+    vec3 position = light.positionRange.xyz;
+    vec3 lightColor = light.colorIntensity.rgb * light.colorIntensity.w;
+    vec3 lightDir = normalize(position - fragPos);
+    float distance = length(position - fragPos);
     
     // Skip if out of range
-    if (distance > light.range) {
+    if (distance > light.positionRange.w) {
         return vec3(0.0);
     }
     
-    // Spotlight cone intensity
-    float theta = dot(lightDir, normalize(-light.direction));
-    float epsilon = light.innerCutOff - light.outerCutOff;
-    float spotIntensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
-    
-    // If outside the cone, no light
-    if (theta < light.outerCutOff) {
-        return vec3(0.0);
+    // Spotlight cone intensity; point lights carry an outer cutoff below -1
+    float spotIntensity = 1.0;
+    float outerCutOff = light.attenuationOuterCutOff.w;
+    if (outerCutOff > -1.5) {
+        float innerCutOff = light.directionInnerCutOff.w;
+        float theta = dot(lightDir, normalize(-light.directionInnerCutOff.xyz));
+        
+        // If outside the cone, no light
+        if (theta < outerCutOff) {
+            return vec3(0.0);
+        }
+        float epsilon = innerCutOff - outerCutOff;
+        spotIntensity = clamp((theta - outerCutOff) / epsilon, 0.0, 1.0);
     }
     
     // Attenuation
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * distance * distance);
+    vec3 k = light.attenuationOuterCutOff.xyz;
+    float attenuation = 1.0 / (k.x + k.y * distance + k.z * distance * distance);
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = diff * light.color * light.intensity;
+    vec3 diffuse = diff * lightColor;
     
     // Specular
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-    vec3 specular = spec * light.color * light.intensity * 0.5;
+    vec3 specular = spec * lightColor * 0.5;
     
     return (diffuse + specular) * attenuation * spotIntensity;
 }
@@ -179,7 +182,21 @@ vec2 poissonDisk[4] = vec2[](
     vec2(0.34495938, 0.29387760)
 );
 
-float ShadowCalculation(vec4 fragPosLightSpace, float bias) {
+float ShadowCalculation(vec3 fragPos, float viewDepth, float bias) {
+    // Pick the first cascade whose slice contains the fragment; nothing is shadowed past the last
+    int cascadeCount = int(uShadowParams.z);
+    int cascade = -1;
+    for (int i = 0; i < cascadeCount; i++) {
+        if (viewDepth < uCascadeSplits[i]) {
+            cascade = i;
+            break;
+        }
+    }
+    if (cascade < 0)
+        return 0.0;
+
+    vec4 fragPosLightSpace = uLightSpaceMatrices[cascade] * vec4(fragPos, 1.0);
+
     // Perspective divide
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
 
@@ -191,7 +208,7 @@ float ShadowCalculation(vec4 fragPosLightSpace, float bias) {
         return 0.0;
 
     // Slope-based bias to prevent shadow acne
-    vec3 lightDir = normalize(-dirLight.direction);
+    vec3 lightDir = normalize(-dirLight.direction.xyz);
     vec3 normal = normalize(vNormal);
     float cosTheta = clamp(dot(normal, lightDir), 0.0, 1.0);
     float slopeBias = 0.005 * tan(acos(cosTheta));
@@ -199,10 +216,12 @@ float ShadowCalculation(vec4 fragPosLightSpace, float bias) {
 
     float currentDepth = projCoords.z - slopeBias;
 
-    // Poisson disk sampling for soft shadows
+    // Poisson disk sampling for soft shadows, about two texels wide in every cascade
+    vec2 texelSize = 1.0 / vec2(textureSize(uShadowMap, 0).xy);
     float shadow = 0.0;
     for (int i = 0; i < 4; i++) {
-        float closestDepth = texture(uShadowMap, projCoords.xy + poissonDisk[i] / 700.0).r;
+        vec2 offset = poissonDisk[i] * texelSize * 2.0;
+        float closestDepth = texture(uShadowMap, vec3(projCoords.xy + offset, float(cascade))).r;
         if (currentDepth > closestDepth) {
             shadow += 0.2;
         }
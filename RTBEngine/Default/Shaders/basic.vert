@@ -1,28 +1,57 @@
 #version 430 core
 
-layout(location = 0) in vec3 aPosition;
-layout(location = 1) in vec3 aNormal;
-layout(location = 2) in vec2 aTexCoords;
-layout(location = 3) in ivec4 aBoneIndices;
+// Packed vertex (Rendering::StaticVertex / SkinnedVertex)
+layout(location = 0) in vec3 aPosition;         // unorm16 in the mesh bounds
+layout(location = 1) in vec2 aNormal;           // octahedral snorm16
+layout(location = 2) in vec2 aTexCoords;        // half float
+layout(location = 3) in ivec4 aBoneIndices;     // skinned meshes only
 layout(location = 4) in vec4 aBoneWeights;
+layout(location = 5) in mat4 aInstanceModel;   // locations 5-8, per instance
+layout(location = 9) in vec4 aInstancePositionScale;
+layout(location = 10) in vec4 aInstancePositionBias;
 
 out vec3 vColor;
 out vec2 vTexCoords;
 out vec3 vNormal;
 out vec3 vFragPos;
-out vec4 vFragPosLightSpace;
+out float vViewDepth;
+
+// Per-frame blocks, filled once per frame by Rendering::FrameUniforms
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewPosition;
+};
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform mat4 uLightSpaceMatrix;
+uniform bool uUseInstancing;
+
+// Mesh bounds the packed positions are relative to; instanced draws read them per instance
+uniform vec3 uPositionScale;
+uniform vec3 uPositionBias;
 
-// Skeletal animation uniforms
-const int MAX_BONES = 100;
-uniform mat4 uBoneTransforms[MAX_BONES];
+// Skeletal animation: all palettes of the frame, this draw's starts at uBoneOffset
+layout(std430, binding = 3) readonly buffer BonePalettes {
+    mat4 uBones[];
+};
 uniform bool uHasAnimation;
+uniform int uBoneOffset;
+
+vec3 DecodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
 
 void main() {
+    mat4 model = uUseInstancing ? aInstanceModel : uModel;
+    vec3 position = uUseInstancing
+        ? aPosition * aInstancePositionScale.xyz + aInstancePositionBias.xyz
+        : aPosition * uPositionScale + uPositionBias;
+    vec3 normal = DecodeOctahedral(aNormal);
+
     vec4 totalPosition = vec4(0.0);
     vec3 totalNormal = vec3(0.0);
     float totalWeight = 0.0;
@@ -32,30 +61,30 @@ void main() {
             int boneIndex = aBoneIndices[i];
             float weight = aBoneWeights[i];
 
-            if (weight > 0.0 && boneIndex >= 0 && boneIndex < MAX_BONES) {
-                mat4 boneTransform = uBoneTransforms[boneIndex];
-                totalPosition += boneTransform * vec4(aPosition, 1.0) * weight;
-                totalNormal += mat3(boneTransform) * aNormal * weight;
+            if (weight > 0.0 && boneIndex >= 0) {
+                mat4 boneTransform = uBones[uBoneOffset + boneIndex];
+                totalPosition += boneTransform * vec4(position, 1.0) * weight;
+                totalNormal += mat3(boneTransform) * normal * weight;
                 totalWeight += weight;
             }
         }
 
         // Fallback: if no bone weights, use original position
         if (totalWeight < 0.001) {
-            totalPosition = vec4(aPosition, 1.0);
-            totalNormal = aNormal;
+            totalPosition = vec4(position, 1.0);
+            totalNormal = normal;
         } else {
             // Normalize the normal after blending
             totalNormal = normalize(totalNormal);
         }
     } else {
-        totalPosition = vec4(aPosition, 1.0);
-        totalNormal = aNormal;
+        totalPosition = vec4(position, 1.0);
+        totalNormal = normal;
     }
 
-    gl_Position = uProjection * uView * uModel * totalPosition;
+    gl_Position = uViewProjection * model * totalPosition;
     vTexCoords = aTexCoords;
-    vFragPos = vec3(uModel * totalPosition);
-    vNormal = mat3(transpose(inverse(uModel))) * totalNormal;
-    vFragPosLightSpace = uLightSpaceMatrix * vec4(vFragPos, 1.0);
+    vFragPos = vec3(model * totalPosition);
+    vNormal = mat3(transpose(inverse(model))) * totalNormal;
+    vViewDepth = -(uView * vec4(vFragPos, 1.0)).z;
 }
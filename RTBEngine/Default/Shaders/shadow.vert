@@ -1,28 +1,48 @@
 #version 430 core
 
-layout (location = 0) in vec3 aPosition;
+layout (location = 0) in vec3 aPosition;       // unorm16 in the mesh bounds
 layout (location = 3) in ivec4 aBoneIndices;
 layout (location = 4) in vec4 aBoneWeights;
+layout (location = 5) in mat4 aInstanceModel;
+layout (location = 9) in vec4 aInstancePositionScale;
+layout (location = 10) in vec4 aInstancePositionBias;
+
+#define MAX_SHADOW_CASCADES 4
+layout(std140, binding = 2) uniform ShadowBlock {
+    mat4 uLightSpaceMatrices[MAX_SHADOW_CASCADES];
+    vec4 uCascadeSplits;
+    vec4 uShadowParams;
+};
+uniform int uCascadeIndex;
 
-uniform mat4 uLightSpaceMatrix;
 uniform mat4 uModel;
+uniform bool uUseInstancing;
+uniform vec3 uPositionScale;
+uniform vec3 uPositionBias;
 
+layout(std430, binding = 3) readonly buffer BonePalettes {
+    mat4 uBones[];
+};
 uniform bool uHasAnimation;
-uniform mat4 uBoneTransforms[100];
+uniform int uBoneOffset;
 
 void main()
 {
-    vec4 position = vec4(aPosition, 1.0);
+    vec3 local = uUseInstancing
+        ? aPosition * aInstancePositionScale.xyz + aInstancePositionBias.xyz
+        : aPosition * uPositionScale + uPositionBias;
+    vec4 position = vec4(local, 1.0);
 
     if (uHasAnimation) {
         mat4 boneTransform = mat4(0.0);
         for (int i = 0; i < 4; i++) {
             if (aBoneIndices[i] >= 0) {
-                boneTransform += uBoneTransforms[aBoneIndices[i]] * aBoneWeights[i];
+                boneTransform += uBones[uBoneOffset + aBoneIndices[i]] * aBoneWeights[i];
             }
         }
         position = boneTransform * position;
     }
 
-    gl_Position = uLightSpaceMatrix * uModel * position;
+    mat4 model = uUseInstancing ? aInstanceModel : uModel;
+    gl_Position = uLightSpaceMatrices[uCascadeIndex] * model * position;
 }
@@ -4,15 +4,19 @@ layout(location = 0) in vec3 aPosition;
 
 out vec3 vTexCoords;
 
-uniform mat4 uView;
-uniform mat4 uProjection;
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec4 uViewPosition;
+};
 
 void main() {
     // Use position as texture coordinates for cubemap sampling
     vTexCoords = aPosition;
     
-    // Transform vertex position
-    vec4 pos = uProjection * uView * vec4(aPosition, 1.0);
+    // Rotation only: dropping the view translation keeps the skybox infinitely far away
+    vec4 pos = uProjection * mat4(mat3(uView)) * vec4(aPosition, 1.0);
     
     // Set z = w so depth is always 1.0 (maximum depth, rendered behind everything)
     gl_Position = pos.xyww;
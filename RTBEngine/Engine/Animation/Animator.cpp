@@ -1,4 +1,5 @@
 #include "Animator.h"
+#include "../Core/Profiler.h"
 #include <cmath>
 
 namespace RTBEngine {
@@ -10,6 +11,7 @@ namespace RTBEngine {
             RTB_PROPERTY(speed)
             RTB_PROPERTY(playing)
             RTB_PROPERTY(looping)
+            RTB_ACCESS(OwnerOnly)
         RTB_END_REGISTER(Animator)
 
         Animator::Animator()
@@ -121,6 +123,8 @@ namespace RTBEngine {
 
         void Animator::UpdateBoneTransforms()
         {
+            RTB_PROFILE_SCOPE("Animator::UpdateBoneTransforms");
+
             if (!skeleton || !currentClip) {
                 return;
             }
@@ -51,6 +51,10 @@ namespace RTBEngine {
             const std::vector<Math::Matrix4>& GetBoneTransforms() const { return finalBoneTransforms; }
             bool HasBones() const { return skeleton && skeleton->GetBoneCount() > 0; }
 
+            // Where this frame's palette sits in the bone palette buffer (-1 = not uploaded)
+            void SetPaletteOffset(int32_t offset) { paletteOffset = offset; }
+            int32_t GetPaletteOffset() const { return paletteOffset; }
+
             // Loaded meshes with bone data
             void SetMeshes(const std::vector<Rendering::Mesh*>& loadedMeshes) { meshes = loadedMeshes; }
             const std::vector<Rendering::Mesh*>& GetMeshes() const { return meshes; }
@@ -73,6 +77,7 @@ namespace RTBEngine {
             bool paused = false;
 
             std::vector<Math::Matrix4> finalBoneTransforms;
+            int32_t paletteOffset = -1;
             std::vector<Rendering::Mesh*> meshes;  // Meshes with bone data
 
             void UpdateBoneTransforms();
@@ -3,6 +3,7 @@
 #include "../Rendering/Rendering.h"
 #include "../ECS/Scene.h"
 #include "../ECS/GameObject.h"
+#include "../ECS/ComponentStorage.h"
 #include "../ECS/LightComponent.h"
 #include "../ECS/RigidBodyComponent.h"
 #include "../ECS/BoxColliderComponent.h"
@@ -10,6 +11,8 @@
 #include "../Animation/Animator.h"
 #include "../Rendering/Lighting/DirectionalLight.h"
 #include "ResourceManager.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 #include "../Physics/PhysicsWorld.h"
 #include "../Physics/PhysicsSystem.h"
 #include "../Audio/AudioSystem.h"
@@ -18,8 +21,11 @@
 #include "../ECS/SceneManager.h"
 #include "../Rendering/Skybox.h"
 #include "../Rendering/Cubemap.h"
+#include "../Rendering/GraphicsContext.h"
 
 #include <backends/imgui_impl_sdl2.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include "Logger.h"
 
@@ -37,15 +43,25 @@ RTBEngine::Core::Application::~Application()
 
 bool RTBEngine::Core::Application::Initialize()
 {
-	window = std::make_unique<Window>(config.window.title, config.window.width, config.window.height, config.window.fullscreen, config.window.maximized);
-	if (!window->Initialize()) {
-		RTB_ERROR("Failed to initialize Window");
-		return false;
-	}
+	// Applies to components created from here on (scene loading happens later)
+	ECS::ComponentStorage::SetSlotsPerChunk(static_cast<size_t>(config.ecs.componentsPerChunk));
+	ECS::ComponentStorage::SetPooled(config.ecs.pooledComponentStorage);
+
+	JobSystem::GetInstance().Initialize(config.jobs.workerThreads);
 
-	window->SetResizeCallback([this](int width, int height) {
-		OnWindowResized(width, height);
-	});
+	Rendering::GraphicsContext::SetAvailable(!config.headless.enabled);
+
+	if (!config.headless.enabled) {
+		window = std::make_unique<Window>(config.window.title, config.window.width, config.window.height, config.window.fullscreen, config.window.maximized);
+		if (!window->Initialize()) {
+			RTB_ERROR("Failed to initialize Window");
+			return false;
+		}
+
+		window->SetResizeCallback([this](int width, int height) {
+			OnWindowResized(width, height);
+		});
+	}
 
 	RTB_INFO("RTBEngine Initializing...");
 
@@ -53,8 +69,67 @@ bool RTBEngine::Core::Application::Initialize()
 
 	Scripting::ComponentRegistry::GetInstance().RegisterBuiltInComponents();
 
+	if (!config.headless.enabled && !InitializeRendering()) {
+		return false;
+	}
+
+	// Initialize physics
+	physicsWorld = new Physics::PhysicsWorld();
+	physicsWorld->Initialize();
+	physicsSystem = new Physics::PhysicsSystem(physicsWorld);
+
+	// Headless runs have no audio device or UI; components already tolerate a missing FMOD system
+	if (!config.headless.enabled) {
+		if (!Audio::AudioSystem::GetInstance().Initialize()) {
+			RTB_ERROR("Failed to initialize audio system");
+			return false;
+		}
+
+		if (!UI::CanvasSystem::GetInstance().Initialize(window->GetSDLWindow())) {
+			RTB_ERROR("Failed to initialize CanvasSystem");
+			return false;
+		}
+	}
+
+	RTB_INFO("RTBEngine Initialized Successfully");
+
+	ECS::SceneManager& sceneMgr = ECS::SceneManager::GetInstance();
+	sceneMgr.Initialize();
+
+	sceneMgr.SetOnSceneLoaded([this](ECS::Scene* scene) {
+		scene->SetParallelUpdateEnabled(config.jobs.parallelSceneUpdate);
+		scene->SetOcclusionCullingEnabled(config.rendering.occlusionCulling);
+		scene->GetOcclusionCuller().SetResolution(config.rendering.occlusionBufferWidth,
+			config.rendering.occlusionBufferHeight);
+
+		// Initialize physics for each BoxColliderComponent
+		for (ECS::BoxColliderComponent* boxCollider : scene->View<ECS::BoxColliderComponent>()) {
+			physicsSystem->InitializeCollider(boxCollider->GetOwner(), boxCollider);
+		}
+
+		if (scene->GetActiveCamera()) {
+			scene->GetActiveCamera()->SetAspectRatio(
+				static_cast<float>(config.window.width) / static_cast<float>(config.window.height)
+			);
+		}
+
+		});
+
+	if (!config.initialScenePath.empty()) {
+		if (!sceneMgr.LoadScene(config.initialScenePath)) {
+			RTB_ERROR("Failed to load scene: " + config.initialScenePath);
+			return false;
+		}
+	}
+
+
+	return true;
+}
+
+bool RTBEngine::Core::Application::InitializeRendering()
+{
 	ResourceManager& resources = ResourceManager::GetInstance();
-	
+
 	// Shader
 	Rendering::Shader* shader = resources.LoadShader(
 		"basic",
@@ -91,57 +166,41 @@ bool RTBEngine::Core::Application::Initialize()
 	// Initialize default skybox
 	skybox = resources.GetDefaultSkybox();
 
+	if (!gpuTimer.Initialize()) {
+		RTB_WARN("GPU pass timing unavailable");
+	}
 
-	// Initialize physics
-	physicsWorld = new Physics::PhysicsWorld();
-	physicsWorld->Initialize();
-	physicsSystem = new Physics::PhysicsSystem(physicsWorld);
-
-	if (!Audio::AudioSystem::GetInstance().Initialize()) {
-		RTB_ERROR("Failed to initialize audio system");
+	if (!frameUniforms.Initialize()) {
+		RTB_ERROR("Failed to create frame uniform buffers");
 		return false;
 	}
 
-	if (!UI::CanvasSystem::GetInstance().Initialize(window->GetSDLWindow())) {
-		RTB_ERROR("Failed to initialize CanvasSystem");
+	if (!lightClusters.Initialize()) {
+		RTB_ERROR("Failed to create light cluster buffers");
 		return false;
 	}
 
-	RTB_INFO("RTBEngine Initialized Successfully");
-
-	ECS::SceneManager& sceneMgr = ECS::SceneManager::GetInstance();
-	sceneMgr.Initialize();
-
-	sceneMgr.SetOnSceneLoaded([this](ECS::Scene* scene) {
-		// Initialize physics for each BoxColliderComponent
-		for (const auto& go : scene->GetGameObjects()) {
-			ECS::BoxColliderComponent* boxCollider = go->GetComponent<ECS::BoxColliderComponent>();
-			if (boxCollider) {
-				physicsSystem->InitializeCollider(go.get(), boxCollider);
-			}
-		}
-
-		if (scene->GetActiveCamera()) {
-			scene->GetActiveCamera()->SetAspectRatio(
-				static_cast<float>(config.window.width) / static_cast<float>(config.window.height)
-			);
-		}
-
-		});
-
-	if (!config.initialScenePath.empty()) {
-		if (!sceneMgr.LoadScene(config.initialScenePath)) {
-			RTB_ERROR("Failed to load scene: " + config.initialScenePath);
-			return false;
-		}
+	if (!bonePalettes.Initialize()) {
+		RTB_ERROR("Failed to create bone palette buffer");
+		return false;
 	}
 
+	Rendering::IndirectDrawBuffer& indirectDraws = Rendering::IndirectDrawBuffer::GetInstance();
+	indirectDraws.SetEnabled(config.rendering.multiDrawIndirect);
+	if (config.rendering.multiDrawIndirect && !indirectDraws.IsEnabled()) {
+		RTB_WARN("Multi-draw indirect not supported, drawing meshes individually");
+	}
 
 	return true;
 }
 
 void RTBEngine::Core::Application::Run()
 {
+	if (config.headless.enabled) {
+		RunHeadless();
+		return;
+	}
+
 	isRunning = true;
 
 	while (isRunning)
@@ -158,20 +217,93 @@ void RTBEngine::Core::Application::Run()
 
 		Audio::AudioSystem::GetInstance().Update();
 
-		// Fixed timestep physics update
-		physicsAccumulator += deltaTime;
+		StepPhysics(ECS::SceneManager::GetInstance().GetActiveScene(), deltaTime);
+
+		Render();
+
+		RTB_PROFILE_FRAME_END();
+	}
+}
+
+void RTBEngine::Core::Application::RunHeadless()
+{
+	using Clock = std::chrono::steady_clock;
+	auto ToMs = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+	const int frameCount = std::max(config.headless.frameCount, 0);
+	const float frameDelta = config.headless.deltaTime;
+
+	std::vector<double> frameTimes;
+	frameTimes.reserve(frameCount);
+	double updateTotal = 0.0;
+	double physicsTotal = 0.0;
+
+	isRunning = true;
+
+	for (int frame = 0; frame < frameCount && isRunning; ++frame)
+	{
+		Clock::time_point frameStart = Clock::now();
+
+		Update(frameDelta);
+		Clock::time_point updateEnd = Clock::now();
+
 		ECS::Scene* scene = ECS::SceneManager::GetInstance().GetActiveScene();
+		StepPhysics(scene, frameDelta);
 		if (scene) {
-			while (physicsAccumulator >= config.physics.timeStep) {
-                scene->FixedUpdate(config.physics.timeStep);
-				physicsSystem->Update(scene, config.physics.timeStep);
-				physicsAccumulator -= config.physics.timeStep;
-			}
-
+			scene->UpdateTransforms();
 		}
+		Clock::time_point frameEnd = Clock::now();
+
+		updateTotal += ToMs(updateEnd - frameStart);
+		physicsTotal += ToMs(frameEnd - updateEnd);
+		frameTimes.push_back(ToMs(frameEnd - frameStart));
+		RTB_PROFILE_FRAME_END();
+	}
 
+	isRunning = false;
 
-		Render();
+	frameTimingStats = FrameTimingStats();
+	if (frameTimes.empty()) return;
+
+	FrameTimingStats& stats = frameTimingStats;
+	stats.frameCount = static_cast<int>(frameTimes.size());
+	for (double t : frameTimes) {
+		stats.totalMs += t;
+	}
+	stats.averageMs = stats.totalMs / stats.frameCount;
+	stats.averageUpdateMs = updateTotal / stats.frameCount;
+	stats.averagePhysicsMs = physicsTotal / stats.frameCount;
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+	auto Percentile = [&frameTimes](double p) {
+		size_t index = static_cast<size_t>(p * (frameTimes.size() - 1) + 0.5);
+		return frameTimes[index];
+	};
+	stats.minMs = frameTimes.front();
+	stats.maxMs = frameTimes.back();
+	stats.p50Ms = Percentile(0.50);
+	stats.p95Ms = Percentile(0.95);
+	stats.p99Ms = Percentile(0.99);
+
+	RTB_INFO("Headless run: " + std::to_string(stats.frameCount) + " frames, total " + std::to_string(stats.totalMs) + " ms");
+	RTB_INFO("Frame ms: avg " + std::to_string(stats.averageMs) + ", min " + std::to_string(stats.minMs) +
+		", p50 " + std::to_string(stats.p50Ms) + ", p95 " + std::to_string(stats.p95Ms) +
+		", p99 " + std::to_string(stats.p99Ms) + ", max " + std::to_string(stats.maxMs));
+	RTB_INFO("Stage avg ms: update " + std::to_string(stats.averageUpdateMs) + ", physics " + std::to_string(stats.averagePhysicsMs));
+}
+
+void RTBEngine::Core::Application::StepPhysics(ECS::Scene* scene, float deltaTime)
+{
+	RTB_PROFILE_SCOPE("Application::StepPhysics");
+
+	// Fixed timestep physics update
+	physicsAccumulator += deltaTime;
+	if (scene) {
+		while (physicsAccumulator >= config.physics.timeStep) {
+			scene->FixedUpdate(config.physics.timeStep);
+			physicsSystem->Update(scene, config.physics.timeStep);
+			physicsAccumulator -= config.physics.timeStep;
+		}
 	}
 }
 
@@ -179,6 +311,13 @@ void RTBEngine::Core::Application::Shutdown()
 {
 	isRunning = false;
 
+#if RTB_ENABLE_PROFILER
+	if (!config.profiler.traceOutputPath.empty()) {
+		Profiler::GetInstance().ExportChromeTrace(config.profiler.traceOutputPath);
+		config.profiler.traceOutputPath.clear();
+	}
+#endif
+
 	UI::CanvasSystem::GetInstance().Shutdown();
 
 	if (physicsWorld) {
@@ -195,14 +334,26 @@ void RTBEngine::Core::Application::Shutdown()
 	ECS::SceneManager::GetInstance().Shutdown();
 
 	ResourceManager::GetInstance().Clear();
+	ECS::ComponentStorage::ReleasePools();
 
 	Audio::AudioSystem::GetInstance().Shutdown();
 
+	gpuTimer.Shutdown();
+	frameUniforms.Shutdown();
+	lightClusters.Shutdown();
+	bonePalettes.Shutdown();
+	Rendering::GeometryArena::GetInstance().Shutdown();
+	Rendering::InstanceBuffer::GetInstance().Shutdown();
+	Rendering::IndirectDrawBuffer::GetInstance().Shutdown();
 	window.reset();
+
+	JobSystem::GetInstance().Shutdown();
 }
 
 void RTBEngine::Core::Application::ProcessInput()
 {
+	RTB_PROFILE_SCOPE("Application::ProcessInput");
+
 	Input::InputManager& input = Input::InputManager::GetInstance();
 
 	SDL_Event event;
@@ -229,6 +380,8 @@ void RTBEngine::Core::Application::ProcessInput()
 
 void RTBEngine::Core::Application::Update(float deltaTime)
 {
+	RTB_PROFILE_SCOPE("Application::Update");
+
 	ECS::Scene* scene = ECS::SceneManager::GetInstance().GetActiveScene();
 	if (scene) {
 		scene->Update(deltaTime);
@@ -239,146 +392,174 @@ void RTBEngine::Core::Application::Update(float deltaTime)
 
 void RTBEngine::Core::Application::Render()
 {
+	RTB_PROFILE_SCOPE("Application::Render");
+
 	ECS::Scene* scene = ECS::SceneManager::GetInstance().GetActiveScene();
 	if (!scene) return;
 
+	// Simulation is done for this frame; resolve world matrices once before the passes read them
+	scene->UpdateTransforms();
+
 	Rendering::Camera* activeCamera = scene->GetActiveCamera();
 	if (!activeCamera) return;
 
-	RenderShadowPass(scene);
+	gpuTimer.BeginFrame();
+	renderStats.Reset();
+	Rendering::GLStateCache::GetInstance().BeginFrame();
+	Rendering::InstanceBuffer::GetInstance().BeginFrame();
+	Rendering::IndirectDrawBuffer::GetInstance().BeginFrame();
+
+	// Shared by every shader this frame; the shadow pass enables the shadow block per light
+	scene->CollectLights();
+	frameUniforms.UpdateCamera(activeCamera);
+	frameUniforms.UpdateLights(scene->GetLights());
+	frameUniforms.UpdateShadow(nullptr, 0, 0.0f);
+	lightClusters.Update(scene->GetLights(), activeCamera, window->GetWidth(), window->GetHeight());
+
+	// Every skinned object's palette goes up in one upload, shared by the shadow and geometry passes
+	bonePalettes.BeginFrame();
+	for (Animation::Animator* animator : scene->View<Animation::Animator>()) {
+		bool skinned = animator->HasBones() && !animator->GetBoneTransforms().empty();
+		animator->SetPaletteOffset(skinned ? bonePalettes.Append(animator->GetBoneTransforms()) : -1);
+	}
+	bonePalettes.Upload();
+
+	gpuTimer.BeginPass("GPU::ShadowPass");
+	RenderShadowPass(scene, activeCamera);
+	gpuTimer.EndPass();
 	RenderGeometryPass(scene, activeCamera);
 
 	UI::CanvasSystem::GetInstance().Update(scene);
 	UI::CanvasSystem::GetInstance().ProcessInput();
+	gpuTimer.BeginPass("GPU::UI");
 	UI::CanvasSystem::GetInstance().RenderAll();
+	gpuTimer.EndPass();
+
+	gpuTimer.EndFrame();
 
 	window->SwapBuffers();
 }
 
-void RTBEngine::Core::Application::RenderShadowPass(ECS::Scene* scene)
+void RTBEngine::Core::Application::RenderShadowPass(ECS::Scene* scene, Rendering::Camera* camera)
 {
+	RTB_PROFILE_SCOPE("Application::RenderShadowPass");
+
+	static constexpr Rendering::UniformId CASCADE_INDEX_UNIFORM("uCascadeIndex");
+
 	Rendering::Shader* shadowShader = ResourceManager::GetInstance().GetShader("shadow");
 	if (!shadowShader) return;
 
 	shadowShader->Bind();
 
-	for (auto& go : scene->GetGameObjects()) {
-		auto* lightComp = go->GetComponent<ECS::LightComponent>();
-		if (!lightComp) continue;
+	Rendering::GLStateCache& state = Rendering::GLStateCache::GetInstance();
+	uint64_t staticSignature = scene->ComputeStaticShadowSignature();
 
+	for (ECS::LightComponent* lightComp : scene->View<ECS::LightComponent>()) {
 		auto* dirLight = dynamic_cast<Rendering::DirectionalLight*>(lightComp->GetLight());
 		if (!dirLight || !dirLight->GetCastShadows()) continue;
 
-		Math::Vector3 sceneCenter(0.0f, 2.0f, 0.0f);
-		float sceneRadius = 50.0f;
-		Math::Matrix4 lightSpaceMatrix = dirLight->GetLightSpaceMatrix(sceneCenter, sceneRadius);
+		Rendering::ShadowMap* shadowMap = dirLight->GetShadowMap();
+		if (!shadowMap) continue;
 
-		shadowShader->SetMatrix4("uLightSpaceMatrix", lightSpaceMatrix);
+		dirLight->UpdateCascades(*camera);
+		const Rendering::ShadowCascade* cascades = dirLight->GetCascades();
+		int cascadeCount = shadowMap->GetCascadeCount();
 
-		Rendering::ShadowMap* shadowMap = dirLight->GetShadowMap();
-		shadowMap->BindForWriting();
+		frameUniforms.UpdateShadow(cascades, cascadeCount, dirLight->GetShadowBias());
 
-		glViewport(0, 0, shadowMap->GetResolution(), shadowMap->GetResolution());
-		glClear(GL_DEPTH_BUFFER_BIT);
+		state.SetViewport(0, 0, shadowMap->GetResolution(), shadowMap->GetResolution());
 
 		// Disable culling to render all faces (fixes shadow issues with single-sided geometry)
-		glDisable(GL_CULL_FACE);
-		RenderSceneDepthOnly(scene, shadowShader);
-		glEnable(GL_CULL_FACE);
+		state.SetCullFace(false);
+
+		for (int cascade = 0; cascade < cascadeCount; ++cascade) {
+			const Math::Matrix4& lightSpaceMatrix = cascades[cascade].lightSpaceMatrix;
+			Math::Frustum frustum(lightSpaceMatrix);
+			shadowShader->SetInt(CASCADE_INDEX_UNIFORM, cascade);
+
+			// Static casters are only redrawn when the cascade moved or the static set changed
+			if (!shadowMap->IsStaticLayerValid(cascade, lightSpaceMatrix, staticSignature)) {
+				shadowMap->BindStaticForWriting(cascade);
+				glClear(GL_DEPTH_BUFFER_BIT);
+				RenderSceneDepthOnly(scene, shadowShader, frustum, ShadowCasterSet::Static);
+				shadowMap->MarkStaticLayerValid(cascade, lightSpaceMatrix, staticSignature);
+				renderStats.shadowPass.staticCacheRebuilds++;
+			}
+
+			// The copy replaces the clear; dynamic casters are depth-tested against the static depth
+			shadowMap->CopyStaticLayer(cascade);
+			shadowMap->BindForWriting(cascade);
+			RenderSceneDepthOnly(scene, shadowShader, frustum, ShadowCasterSet::Dynamic);
+		}
+
+		state.SetCullFace(true);
 
 		shadowMap->Unbind();
 	}
 
-	glViewport(0, 0, window->GetWidth(), window->GetHeight());
+	state.SetViewport(0, 0, window->GetWidth(), window->GetHeight());
 }
 
-void RTBEngine::Core::Application::RenderSceneDepthOnly(ECS::Scene* scene, Rendering::Shader* shader)
+void RTBEngine::Core::Application::RenderSceneDepthOnly(ECS::Scene* scene, Rendering::Shader* shader, const Math::Frustum& frustum, ShadowCasterSet casters)
 {
-	for (auto& go : scene->GetGameObjects()) {
-		auto* meshRenderer = go->GetComponent<ECS::MeshRenderer>();
-		if (!meshRenderer) continue;
-
-		Math::Matrix4 modelMatrix = go->GetTransform().GetModelMatrix();
-		shader->SetMatrix4("uModel", modelMatrix);
-
-		auto* animator = go->GetComponent<Animation::Animator>();
-		if (animator) {
-			shader->SetBool("uHasAnimation", true);
-			const auto& boneTransforms = animator->GetBoneTransforms();
-			for (size_t i = 0; i < boneTransforms.size() && i < 100; ++i) {
-				shader->SetMatrix4("uBoneTransforms[" + std::to_string(i) + "]", boneTransforms[i]);
-			}
-		}
-		else {
-			shader->SetBool("uHasAnimation", false);
-		}
+	shadowQueue.Clear();
 
-		for (auto* mesh : meshRenderer->GetMeshes()) {
-			mesh->Draw();
+	bool wantStatic = casters == ShadowCasterSet::Static;
+	for (ECS::MeshRenderer* meshRenderer : scene->View<ECS::MeshRenderer>()) {
+		if (!meshRenderer->IsEnabled() || !meshRenderer->GetOwner()->IsActive()) continue;
+		if (meshRenderer->IsStaticShadowCaster() != wantStatic) continue;
+
+		if (!frustum.Intersects(meshRenderer->GetWorldBounds())) {
+			renderStats.shadowPass.culled++;
+			continue;
 		}
+		renderStats.shadowPass.drawn++;
+
+		meshRenderer->SubmitDepth(shadowQueue);
 	}
+
+	shadowQueue.Sort();
+	shadowQueue.ExecuteDepthOnly(shader, &renderStats.shadowPass);
 }
 
 void RTBEngine::Core::Application::RenderGeometryPass(ECS::Scene* scene, Rendering::Camera* camera)
 {
+	RTB_PROFILE_SCOPE("Application::RenderGeometryPass");
+
+	gpuTimer.BeginPass("GPU::GeometryPass");
+
 	glClearColor(config.rendering.clearColorR, config.rendering.clearColorG,
 		config.rendering.clearColorB, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	Rendering::Shader* shader = ResourceManager::GetInstance().GetShader("basic");
-	if (!shader) return;
-
-	shader->Bind();
+	if (!shader) {
+		gpuTimer.EndPass();
+		return;
+	}
 
-	int pointLightIndex = 0;
-	int spotLightIndex = 0;
+	// Lights, camera and the shadow matrix are already in the uniform blocks; only the shadow
+	// map of the last shadow caster (the one the shadow block describes) still needs binding
 	Rendering::DirectionalLight* shadowCastingLight = nullptr;
-
-	for (auto& go : scene->GetGameObjects()) {
-		auto* lightComp = go->GetComponent<ECS::LightComponent>();
-		if (!lightComp || !lightComp->GetLight()) continue;
-
-		Rendering::Light* light = lightComp->GetLight();
-
-		if (light->GetType() == Rendering::LightType::Directional) {
-			light->ApplyToShader(shader);
-
-			auto* dirLight = static_cast<Rendering::DirectionalLight*>(light);
-			if (dirLight->GetCastShadows()) {
-				shadowCastingLight = dirLight;
-			}
-		}
-		else if (light->GetType() == Rendering::LightType::Point) {
-			static_cast<Rendering::PointLight*>(light)->ApplyToShader(shader, pointLightIndex++);
-		}
-		else if (light->GetType() == Rendering::LightType::Spot) {
-			static_cast<Rendering::SpotLight*>(light)->ApplyToShader(shader, spotLightIndex++);
+	for (ECS::LightComponent* lightComp : scene->View<ECS::LightComponent>()) {
+		auto* dirLight = dynamic_cast<Rendering::DirectionalLight*>(lightComp->GetLight());
+		if (dirLight && dirLight->GetCastShadows()) {
+			shadowCastingLight = dirLight;
 		}
 	}
 
-	shader->SetInt("numPointLights", pointLightIndex);
-	shader->SetInt("numSpotLights", spotLightIndex);
-
 	if (shadowCastingLight) {
-		shader->SetBool("uHasShadows", true);
-		shader->SetFloat("uShadowBias", shadowCastingLight->GetShadowBias());
-
 		shadowCastingLight->GetShadowMap()->BindForReading(1);
-		shader->SetInt("uShadowMap", 1);
-
-		Math::Vector3 sceneCenter(0.0f, 2.0f, 0.0f);
-		float sceneRadius = 50.0f;
-		Math::Matrix4 lightSpaceMatrix = shadowCastingLight->GetLightSpaceMatrix(sceneCenter, sceneRadius);
-		shader->SetMatrix4("uLightSpaceMatrix", lightSpaceMatrix);
-	}
-	else {
-		shader->SetBool("uHasShadows", false);
 	}
 
-	scene->Render(camera);
+	scene->Render(camera, &renderStats.geometryPass);
+
+	gpuTimer.EndPass();
 
 	// Render skybox after geometry (uses GL_LEQUAL depth test)
 	if (skybox && skybox->IsEnabled() && scene->IsSkyboxEnabled()) {
+		gpuTimer.BeginPass("GPU::Skybox");
+
 		// Use scene-specific cubemap if available, otherwise use default
 		Rendering::Cubemap* sceneCubemap = scene->GetSkyboxCubemap();
 		if (sceneCubemap) {
@@ -388,13 +569,14 @@ void RTBEngine::Core::Application::RenderGeometryPass(ECS::Scene* scene, Renderi
 			skybox->SetCubemap(ResourceManager::GetInstance().GetDefaultCubemap());
 		}
 		skybox->Render(camera);
+		gpuTimer.EndPass();
 	}
 
 }
 
 void RTBEngine::Core::Application::OnWindowResized(int width, int height)
 {
-	glViewport(0, 0, width, height);
+	Rendering::GLStateCache::GetInstance().SetViewport(0, 0, width, height);
 
 	ECS::Scene* scene = ECS::SceneManager::GetInstance().GetActiveScene();
 	if (scene && scene->GetActiveCamera()) {
@@ -1,8 +1,17 @@
 #pragma once
 #include <SDL.h>
 #include <memory>
+#include <vector>
 #include "Window.h"
 #include "ApplicationConfig.h"
+#include "../Rendering/GPUTimer.h"
+#include "../Rendering/RenderStats.h"
+#include "../Rendering/GLStateCache.h"
+#include "../Rendering/RenderQueue.h"
+#include "../Rendering/FrameUniforms.h"
+#include "../Rendering/LightClusters.h"
+#include "../Rendering/BonePaletteBuffer.h"
+#include "../Math/Geometry/Frustum.h"
 
 namespace RTBEngine {
 	namespace ECS {
@@ -24,6 +33,20 @@ namespace RTBEngine {
 
 namespace RTBEngine {
 	namespace Core {
+		// Frame times of the last headless run, in milliseconds
+		struct FrameTimingStats {
+			int frameCount = 0;
+			double totalMs = 0.0;
+			double averageMs = 0.0;
+			double minMs = 0.0;
+			double maxMs = 0.0;
+			double p50Ms = 0.0;
+			double p95Ms = 0.0;
+			double p99Ms = 0.0;
+			double averageUpdateMs = 0.0;
+			double averagePhysicsMs = 0.0;
+		};
+
 		class Application {
 		public:
 			explicit Application(const ApplicationConfig& config);
@@ -37,17 +60,33 @@ namespace RTBEngine {
 			void RequestExit() { isRunning = false; }
 			Window* GetWindow() { return window.get(); }
 			const ApplicationConfig& GetConfig() const { return config; }
+			bool IsHeadless() const { return config.headless.enabled; }
+			const FrameTimingStats& GetFrameTimingStats() const { return frameTimingStats; }
+
+			// GPU time per pass (shadow, geometry, skybox, UI), a few frames behind the CPU
+			const std::vector<Rendering::GPUPassTiming>& GetGPUPassTimings() const { return gpuTimer.GetResults(); }
+			double GetGPUPassTimeMs(const std::string& passName) const { return gpuTimer.GetPassTimeMs(passName); }
+
+			// Drawn/culled MeshRenderers per pass for the last rendered frame
+			const Rendering::RenderStats& GetRenderStats() const { return renderStats; }
+
+			// Issued vs. skipped GL state changes for the last rendered frame
+			const Rendering::GLStateStats& GetGLStateStats() const { return Rendering::GLStateCache::GetInstance().GetFrameStats(); }
 
 			void ProcessInput();
 			void Update(float deltaTime);
 			void Render();
 
-			void RenderShadowPass(ECS::Scene* scene);
+			void RenderShadowPass(ECS::Scene* scene, Rendering::Camera* camera);
 			void RenderGeometryPass(ECS::Scene* scene, Rendering::Camera* camera);
 			void SetIsRunning(bool value) { isRunning = value; }
 
 		private:
-			void RenderSceneDepthOnly(ECS::Scene* scene, Rendering::Shader* shader);
+			bool InitializeRendering();
+			void RunHeadless();
+			void StepPhysics(ECS::Scene* scene, float deltaTime);
+			enum class ShadowCasterSet { Static, Dynamic };
+			void RenderSceneDepthOnly(ECS::Scene* scene, Rendering::Shader* shader, const Math::Frustum& frustum, ShadowCasterSet casters);
 			void OnWindowResized(int width, int height);
 			ApplicationConfig config;
 
@@ -64,6 +103,14 @@ namespace RTBEngine {
 
 			Rendering::Skybox* skybox = nullptr;
 
+			FrameTimingStats frameTimingStats;
+			Rendering::GPUTimer gpuTimer;
+			Rendering::RenderStats renderStats;
+			Rendering::RenderQueue shadowQueue;
+			Rendering::FrameUniforms frameUniforms;
+			Rendering::LightClusters lightClusters;
+			Rendering::BonePaletteBuffer bonePalettes;
+
 			Application(const Application&) = delete;
 			Application& operator=(const Application&) = delete;
 		};
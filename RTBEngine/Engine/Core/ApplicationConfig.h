@@ -24,12 +24,50 @@ namespace RTBEngine {
             float clearColorR = 0.1f;
             float clearColorG = 0.1f;
             float clearColorB = 0.1f;
+            // Draw unskinned meshes of a material with one glMultiDrawElementsIndirect when supported
+            bool multiDrawIndirect = true;
+            // Skip MeshRenderers hidden behind occluders, tested on the CPU before submission.
+            // Off by default: it only pays off in scenes with MeshRenderers marked as occluders.
+            bool occlusionCulling = false;
+            int occlusionBufferWidth = 256;
+            int occlusionBufferHeight = 128;
+        };
+
+        struct ECSConfig {
+            // Allocate components from per-type contiguous pools instead of individual heap blocks
+            bool pooledComponentStorage = false;
+            int componentsPerChunk = 256;
+        };
+
+        struct JobSystemConfig {
+            // Worker threads besides the main thread. -1 = hardware threads - 1, 0 = run jobs inline
+            int workerThreads = -1;
+            // Run parallel-safe GameObjects (see ComponentAccess) on the workers during Scene::Update.
+            // Off by default: the parallel batch updates before the serial one, not in scene order.
+            bool parallelSceneUpdate = false;
+        };
+
+        struct HeadlessConfig {
+            // No window, GL context, UI or audio. Run() steps frameCount frames of deltaTime each
+            // as fast as possible and logs frame timing statistics.
+            bool enabled = false;
+            int frameCount = 600;
+            float deltaTime = 1.0f / 60.0f;
+        };
+
+        struct ProfilerConfig {
+            // Chrome trace JSON written on Shutdown; empty = no export
+            std::string traceOutputPath;
         };
 
         struct ApplicationConfig {
             WindowConfig window;
             PhysicsConfig physics;
             RenderingConfig rendering;
+            ECSConfig ecs;
+            JobSystemConfig jobs;
+            HeadlessConfig headless;
+            ProfilerConfig profiler;
             std::string initialScenePath;
         };
 
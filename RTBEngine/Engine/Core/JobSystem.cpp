@@ -0,0 +1,239 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include "../RTBEngine.h"
+
+namespace RTBEngine {
+    namespace Core {
+
+        namespace {
+            // Queue owned by the current thread; 0 for the main thread and any non-worker thread
+            thread_local size_t currentQueueIndex = 0;
+        }
+
+        JobSystem& JobSystem::GetInstance()
+        {
+            static JobSystem instance;
+            return instance;
+        }
+
+        JobSystem::~JobSystem()
+        {
+            Shutdown();
+        }
+
+        bool JobSystem::Initialize(int workerCount)
+        {
+            if (isInitialized) {
+                return true;
+            }
+
+            if (workerCount < 0) {
+                int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+                workerCount = std::max(hardwareThreads - 1, 0);
+            }
+
+            queues.clear();
+            for (int i = 0; i < workerCount + 1; ++i) {
+                queues.push_back(std::make_unique<WorkerQueue>());
+            }
+
+            running = true;
+            for (int i = 0; i < workerCount; ++i) {
+                workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<size_t>(i + 1));
+            }
+
+            isInitialized = true;
+            RTB_INFO("JobSystem: " + std::to_string(workerCount) + " worker threads");
+            return true;
+        }
+
+        void JobSystem::Shutdown()
+        {
+            if (!isInitialized) {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                running = false;
+            }
+            wakeCondition.notify_all();
+
+            for (std::thread& worker : workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+            workers.clear();
+
+            // Finish whatever is left so counters held by callers still reach zero
+            while (TryExecuteOne()) {
+            }
+            queues.clear();
+            queuedJobs = 0;
+
+            isInitialized = false;
+        }
+
+        void JobSystem::Run(Job job, JobCounter* counter, JobCounter* dependency)
+        {
+            if (!job) return;
+
+            if (counter) {
+                counter->pending.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+            if (dependency) {
+                std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+                if (!dependency->IsDone()) {
+                    dependency->continuations.emplace_back(std::move(job), counter);
+                    return;
+                }
+            }
+
+            Enqueue(PendingJob{ std::move(job), counter });
+        }
+
+        void JobSystem::Wait(JobCounter& counter)
+        {
+            while (!counter.IsDone()) {
+                if (!TryExecuteOne()) {
+                    std::this_thread::yield();
+                }
+            }
+
+            // Let the thread that finished the last job release the counter
+            std::lock_guard<std::mutex> lock(counter.continuationMutex);
+        }
+
+        void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn)
+        {
+            if (count == 0) return;
+
+            size_t threadCount = workers.size() + 1;
+            if (grainSize == 0) {
+                // A few ranges per thread so faster threads can steal the remainder
+                grainSize = std::max<size_t>(count / (threadCount * 4), 1);
+            }
+
+            if (workers.empty() || count <= grainSize) {
+                fn(0, count);
+                return;
+            }
+
+            JobCounter counter;
+            for (size_t begin = grainSize; begin < count; begin += grainSize) {
+                size_t end = std::min(begin + grainSize, count);
+                Run([&fn, begin, end]() { fn(begin, end); }, &counter);
+            }
+
+            // The caller takes the first range itself
+            fn(0, std::min(grainSize, count));
+            Wait(counter);
+        }
+
+        void JobSystem::Enqueue(PendingJob job)
+        {
+            if (workers.empty() || queues.empty()) {
+                Execute(job);
+                return;
+            }
+
+            size_t index = currentQueueIndex < queues.size() ? currentQueueIndex : 0;
+            {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                queues[index]->jobs.push_back(std::move(job));
+            }
+            queuedJobs.fetch_add(1, std::memory_order_release);
+
+            // Taking the lock orders this with a worker that is about to sleep
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+            }
+            wakeCondition.notify_one();
+        }
+
+        bool JobSystem::TryExecuteOne()
+        {
+            PendingJob job;
+            if (!PopOrSteal(job)) {
+                return false;
+            }
+            Execute(job);
+            return true;
+        }
+
+        bool JobSystem::PopOrSteal(PendingJob& out)
+        {
+            if (queues.empty()) return false;
+
+            size_t own = currentQueueIndex < queues.size() ? currentQueueIndex : 0;
+
+            // Newest job from our own queue keeps the working set warm
+            {
+                WorkerQueue& queue = *queues[own];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.jobs.empty()) {
+                    out = std::move(queue.jobs.back());
+                    queue.jobs.pop_back();
+                    queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+                    return true;
+                }
+            }
+
+            // Oldest job from someone else
+            for (size_t offset = 1; offset < queues.size(); ++offset) {
+                WorkerQueue& victim = *queues[(own + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.jobs.empty()) {
+                    out = std::move(victim.jobs.front());
+                    victim.jobs.pop_front();
+                    queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void JobSystem::Execute(PendingJob& job)
+        {
+            job.job();
+
+            JobCounter* counter = job.counter;
+            if (!counter) return;
+
+            // Decrement under the lock: Wait() takes the same lock before returning, so the
+            // counter cannot be destroyed while we still touch it
+            std::vector<std::pair<Job, JobCounter*>> released;
+            {
+                std::lock_guard<std::mutex> lock(counter->continuationMutex);
+                if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    released.swap(counter->continuations);
+                }
+            }
+
+            // Last job on this counter: release everything that was waiting on it
+            for (auto& continuation : released) {
+                Enqueue(PendingJob{ std::move(continuation.first), continuation.second });
+            }
+        }
+
+        void JobSystem::WorkerLoop(size_t queueIndex)
+        {
+            currentQueueIndex = queueIndex;
+
+            while (running) {
+                if (TryExecuteOne()) {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wakeCondition.wait(lock, [this]() {
+                    return queuedJobs.load(std::memory_order_acquire) > 0 || !running;
+                });
+            }
+        }
+
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Core {
+
+        using Job = std::function<void()>;
+
+        // Counts unfinished jobs. A job run with a counter increments it when queued and decrements
+        // it when done; jobs that depend on the counter are released once it drops to zero.
+        // Only reuse a counter after waiting on it.
+        class JobCounter {
+        public:
+            JobCounter() = default;
+
+            JobCounter(const JobCounter&) = delete;
+            JobCounter& operator=(const JobCounter&) = delete;
+
+            bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+            int GetPending() const { return pending.load(std::memory_order_acquire); }
+
+        private:
+            friend class JobSystem;
+
+            std::atomic<int> pending{ 0 };
+            std::mutex continuationMutex;
+            std::vector<std::pair<Job, JobCounter*>> continuations;
+        };
+
+        // Work-stealing thread pool. Each worker owns a deque: it pops its own newest job and
+        // steals the oldest job from others when empty. Threads that are not workers (main thread)
+        // share queue 0 and help execute jobs while they Wait.
+        class JobSystem {
+        public:
+            static JobSystem& GetInstance();
+
+            // workerCount < 0 uses hardware_concurrency - 1; 0 runs every job inline on the caller
+            bool Initialize(int workerCount = -1);
+            void Shutdown();
+
+            bool IsInitialized() const { return isInitialized; }
+            int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+
+            // Queues a job. 'counter' is signalled when it finishes; it starts only once 'dependency' is done.
+            void Run(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+            // Blocks until the counter reaches zero, running queued jobs in the meantime
+            void Wait(JobCounter& counter);
+
+            // Runs fn(begin, end) over [0, count) in ranges of grainSize (0 = pick one per worker load). Blocks.
+            void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn);
+
+        private:
+            JobSystem() = default;
+            ~JobSystem();
+
+            JobSystem(const JobSystem&) = delete;
+            JobSystem& operator=(const JobSystem&) = delete;
+
+            struct PendingJob {
+                Job job;
+                JobCounter* counter = nullptr;
+            };
+
+            struct WorkerQueue {
+                std::mutex mutex;
+                std::deque<PendingJob> jobs;
+            };
+
+            void Enqueue(PendingJob job);
+            bool TryExecuteOne();
+            bool PopOrSteal(PendingJob& out);
+            void Execute(PendingJob& job);
+            void WorkerLoop(size_t queueIndex);
+
+            std::vector<std::unique_ptr<WorkerQueue>> queues;  // [0] shared by non-worker threads
+            std::vector<std::thread> workers;
+
+            std::mutex sleepMutex;
+            std::condition_variable wakeCondition;
+            std::atomic<int> queuedJobs{ 0 };
+            std::atomic<bool> running{ false };
+            bool isInitialized = false;
+        };
+
+    }
+}
@@ -0,0 +1,189 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include "../RTBEngine.h"
+
+namespace RTBEngine {
+    namespace Core {
+
+        namespace {
+            thread_local uint32_t scopeDepth = 0;
+
+            void WriteJsonString(std::ofstream& out, const char* text)
+            {
+                out << '"';
+                for (const char* c = text ? text : ""; *c; ++c) {
+                    if (*c == '"' || *c == '\\') {
+                        out << '\\';
+                    }
+                    out << *c;
+                }
+                out << '"';
+            }
+        }
+
+        Profiler& Profiler::GetInstance()
+        {
+            static Profiler instance;
+            return instance;
+        }
+
+        Profiler::Profiler()
+            : startTime(std::chrono::steady_clock::now())
+        {
+        }
+
+        uint32_t& Profiler::CurrentDepth()
+        {
+            return scopeDepth;
+        }
+
+        Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+        {
+            thread_local ThreadBuffer* threadBuffer = nullptr;
+            if (!threadBuffer) {
+                std::lock_guard<std::mutex> lock(buffersMutex);
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->threadId = nextThreadId++;
+                buffer->events.resize(EVENTS_PER_THREAD);
+                threadBuffer = buffer.get();
+                buffers.push_back(std::move(buffer));
+            }
+            return *threadBuffer;
+        }
+
+        Profiler::ThreadBuffer& Profiler::GetExternalBuffer(uint32_t trackId)
+        {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            auto it = externalBuffers.find(trackId);
+            if (it != externalBuffers.end()) {
+                return *it->second;
+            }
+
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = trackId;
+            buffer->events.resize(EVENTS_PER_THREAD);
+            ThreadBuffer* ptr = buffer.get();
+            buffers.push_back(std::move(buffer));
+            externalBuffers[trackId] = ptr;
+            return *ptr;
+        }
+
+        void Profiler::Push(ThreadBuffer& buffer, const ProfileEvent& event)
+        {
+            std::lock_guard<std::mutex> lock(buffer.mutex);
+            buffer.events[buffer.writeCount % EVENTS_PER_THREAD] = event;
+            ++buffer.writeCount;
+        }
+
+        void Profiler::Record(const ProfileEvent& event)
+        {
+            Push(GetThreadBuffer(), event);
+        }
+
+        void Profiler::RecordExternal(const char* name, uint64_t startNs, uint64_t endNs, uint32_t trackId)
+        {
+            ProfileEvent event;
+            event.name = name;
+            event.startNs = startNs;
+            event.endNs = endNs;
+            Push(GetExternalBuffer(trackId), event);
+        }
+
+        void Profiler::EndFrame()
+        {
+            struct FrameTotal {
+                double ms = 0.0;
+                int calls = 0;
+            };
+            std::unordered_map<std::string, FrameTotal> frameTotals;
+
+            {
+                std::lock_guard<std::mutex> buffersLock(buffersMutex);
+                for (auto& buffer : buffers) {
+                    std::lock_guard<std::mutex> lock(buffer->mutex);
+
+                    // Events overwritten before we got to them are lost to the averages
+                    uint64_t first = std::max(buffer->aggregatedCount,
+                        buffer->writeCount > EVENTS_PER_THREAD ? buffer->writeCount - EVENTS_PER_THREAD : 0);
+                    for (uint64_t i = first; i < buffer->writeCount; ++i) {
+                        const ProfileEvent& event = buffer->events[i % EVENTS_PER_THREAD];
+                        FrameTotal& total = frameTotals[event.name];
+                        total.ms += (event.endNs - event.startNs) / 1000000.0;
+                        ++total.calls;
+                    }
+                    buffer->aggregatedCount = buffer->writeCount;
+                }
+            }
+
+            // Scopes that did not run this frame count as zero
+            for (auto& entry : scopeStats) {
+                if (frameTotals.find(entry.first) == frameTotals.end()) {
+                    frameTotals[entry.first] = FrameTotal();
+                }
+            }
+
+            for (const auto& entry : frameTotals) {
+                ProfileScopeStats& stats = scopeStats[entry.first];
+                if (stats.samples == ProfileScopeStats::WINDOW) {
+                    stats.windowSum -= stats.history[stats.head];
+                }
+                else {
+                    ++stats.samples;
+                }
+                stats.history[stats.head] = entry.second.ms;
+                stats.windowSum += entry.second.ms;
+                stats.head = (stats.head + 1) % ProfileScopeStats::WINDOW;
+
+                stats.lastFrameMs = entry.second.ms;
+                stats.lastFrameCalls = entry.second.calls;
+                stats.averageMs = stats.windowSum / stats.samples;
+            }
+        }
+
+        double Profiler::GetAverageMs(const std::string& name) const
+        {
+            auto it = scopeStats.find(name);
+            return it != scopeStats.end() ? it->second.averageMs : 0.0;
+        }
+
+        bool Profiler::ExportChromeTrace(const std::string& path) const
+        {
+            std::ofstream out(path);
+            if (!out.is_open()) {
+                RTB_ERROR("Profiler: Failed to open trace file: " + path);
+                return false;
+            }
+
+            out << std::fixed << std::setprecision(3);
+            out << "{\"traceEvents\":[";
+            bool first = true;
+
+            std::lock_guard<std::mutex> buffersLock(buffersMutex);
+            for (const auto& buffer : buffers) {
+                std::lock_guard<std::mutex> lock(buffer->mutex);
+
+                uint64_t begin = buffer->writeCount > EVENTS_PER_THREAD ? buffer->writeCount - EVENTS_PER_THREAD : 0;
+                for (uint64_t i = begin; i < buffer->writeCount; ++i) {
+                    const ProfileEvent& event = buffer->events[i % EVENTS_PER_THREAD];
+
+                    out << (first ? "\n" : ",\n");
+                    first = false;
+
+                    // Complete events; timestamps are in microseconds
+                    out << "{\"name\":";
+                    WriteJsonString(out, event.name);
+                    out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadId
+                        << ",\"ts\":" << event.startNs / 1000.0
+                        << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0 << "}";
+                }
+            }
+
+            out << "\n]}\n";
+            RTB_INFO("Profiler: Wrote trace to " + path);
+            return true;
+        }
+
+    }
+}
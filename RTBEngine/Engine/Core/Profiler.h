@@ -0,0 +1,148 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Set to 0 (e.g. in the project's preprocessor definitions) to compile every profiling macro out
+#ifndef RTB_ENABLE_PROFILER
+#define RTB_ENABLE_PROFILER 1
+#endif
+
+namespace RTBEngine {
+    namespace Core {
+
+        // One closed scope. Names must have static storage (string literals).
+        struct ProfileEvent {
+            const char* name = nullptr;
+            uint64_t startNs = 0;
+            uint64_t endNs = 0;
+            uint32_t depth = 0;
+        };
+
+        // Rolling per-frame cost of one scope name over the last WINDOW frames
+        struct ProfileScopeStats {
+            static constexpr int WINDOW = 120;
+
+            double averageMs = 0.0;     // Average total time per frame
+            double lastFrameMs = 0.0;
+            int lastFrameCalls = 0;
+
+            std::array<double, WINDOW> history{};
+            int head = 0;
+            int samples = 0;
+            double windowSum = 0.0;
+        };
+
+        // Low-overhead hierarchical CPU profiler. Each thread records into its own ring buffer;
+        // EndFrame (main thread, once per frame) folds new events into rolling averages.
+        class Profiler {
+        public:
+            static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+            static Profiler& GetInstance();
+
+            // Toggled from the main thread while workers check it; scopes opened before a change still close
+            void SetEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+            bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+            // Nanoseconds since the profiler was created
+            uint64_t Now() const {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - startTime).count());
+            }
+
+            void Record(const ProfileEvent& event);
+
+            // External timings (e.g. GPU passes) shown on their own track in the trace and in the averages.
+            // Track ids start at EXTERNAL_TRACK_BASE so they never clash with thread ids.
+            static constexpr uint32_t EXTERNAL_TRACK_BASE = 1000;
+            void RecordExternal(const char* name, uint64_t startNs, uint64_t endNs, uint32_t trackId);
+
+            void EndFrame();
+
+            const std::unordered_map<std::string, ProfileScopeStats>& GetScopeStats() const { return scopeStats; }
+            double GetAverageMs(const std::string& name) const;
+
+            // Writes the buffered events as Chrome trace JSON (chrome://tracing, Perfetto)
+            bool ExportChromeTrace(const std::string& path) const;
+
+            uint32_t& CurrentDepth();
+
+        private:
+            Profiler();
+            ~Profiler() = default;
+
+            Profiler(const Profiler&) = delete;
+            Profiler& operator=(const Profiler&) = delete;
+
+            struct ThreadBuffer {
+                uint32_t threadId = 0;
+                std::mutex mutex;  // Uncontended except while aggregating or exporting
+                std::vector<ProfileEvent> events;
+                uint64_t writeCount = 0;
+                uint64_t aggregatedCount = 0;
+            };
+
+            ThreadBuffer& GetThreadBuffer();
+            ThreadBuffer& GetExternalBuffer(uint32_t trackId);
+            static void Push(ThreadBuffer& buffer, const ProfileEvent& event);
+
+            std::chrono::steady_clock::time_point startTime;
+            std::atomic<bool> enabled{ true };
+
+            mutable std::mutex buffersMutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            uint32_t nextThreadId = 0;
+            std::unordered_map<uint32_t, ThreadBuffer*> externalBuffers;
+
+            std::unordered_map<std::string, ProfileScopeStats> scopeStats;
+        };
+
+        // RAII scope used by RTB_PROFILE_SCOPE
+        class ProfileScope {
+        public:
+            explicit ProfileScope(const char* name) {
+                Profiler& profiler = Profiler::GetInstance();
+                if (!profiler.IsEnabled()) {
+                    return;
+                }
+                event.name = name;
+                event.depth = profiler.CurrentDepth()++;
+                event.startNs = profiler.Now();
+            }
+
+            ~ProfileScope() {
+                if (!event.name) {
+                    return;
+                }
+                Profiler& profiler = Profiler::GetInstance();
+                event.endNs = profiler.Now();
+                profiler.CurrentDepth()--;
+                profiler.Record(event);
+            }
+
+            ProfileScope(const ProfileScope&) = delete;
+            ProfileScope& operator=(const ProfileScope&) = delete;
+
+        private:
+            ProfileEvent event;
+        };
+
+    }
+}
+
+#if RTB_ENABLE_PROFILER
+#define RTB_PROFILE_CONCAT_INNER(a, b) a##b
+#define RTB_PROFILE_CONCAT(a, b) RTB_PROFILE_CONCAT_INNER(a, b)
+#define RTB_PROFILE_SCOPE(name) ::RTBEngine::Core::ProfileScope RTB_PROFILE_CONCAT(rtbProfileScope_, __LINE__)(name)
+#define RTB_PROFILE_FRAME_END() ::RTBEngine::Core::Profiler::GetInstance().EndFrame()
+#else
+#define RTB_PROFILE_SCOPE(name) ((void)0)
+#define RTB_PROFILE_FRAME_END() ((void)0)
+#endif
@@ -1,7 +1,10 @@
 #include "ResourceManager.h"
+#include "../Rendering/GraphicsContext.h"
 #include "../Scripting/SceneLoader.h"
 #include "../ECS/Scene.h"
 #include <iostream>
+#include <sstream>
+#include <tuple>
 #include "../RTBEngine.h"
 
 namespace RTBEngine {
@@ -32,6 +35,11 @@ namespace RTBEngine {
 
         Rendering::Shader* ResourceManager::LoadShader(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath)
         {
+            // Headless: GPU-only resources are skipped, callers already handle nullptr
+            if (!Rendering::GraphicsContext::IsAvailable()) {
+                return nullptr;
+            }
+
             // Check if already loaded
             auto existing = GetShader(name);
             if (existing) {
@@ -62,6 +70,10 @@ namespace RTBEngine {
 
         Rendering::Texture* ResourceManager::LoadTexture(const std::string& path)
         {
+            if (!Rendering::GraphicsContext::IsAvailable()) {
+                return nullptr;
+            }
+
             auto existing = GetTexture(path);
             if (existing) {
                 return existing;
@@ -95,23 +107,43 @@ namespace RTBEngine {
             return meshes.empty() ? nullptr : meshes[0];
         }
 
-        const std::vector<Rendering::Mesh*>& ResourceManager::GetModelMeshes(const std::string& path)
+        std::string ResourceManager::MakeModelKey(const std::string& path, const Rendering::MeshOptimizeOptions& optimizeOptions)
         {
-            auto it = modelMeshPtrs.find(path);
+            // Default options keep the bare path; anything else appends every option exactly
+            if (optimizeOptions == Rendering::MeshOptimizeOptions()) {
+                return path;
+            }
+
+            std::ostringstream key;
+            key << path << '|' << std::hexfloat
+                << optimizeOptions.enabled << optimizeOptions.weldVertices << optimizeOptions.optimizeVertexCache
+                << optimizeOptions.optimizeOverdraw << optimizeOptions.optimizeVertexFetch
+                << ',' << optimizeOptions.cacheSize << ',' << optimizeOptions.overdrawThreshold
+                << ',' << optimizeOptions.lodLevels << ',' << optimizeOptions.lodReduction
+                << ',' << optimizeOptions.lodMaxError << ',' << optimizeOptions.lodScreenSize;
+            return key.str();
+        }
+
+        const std::vector<Rendering::Mesh*>& ResourceManager::GetModelMeshes(const std::string& path,
+            const Rendering::MeshOptimizeOptions& optimizeOptions)
+        {
+            auto it = modelMeshPtrs.find(MakeModelKey(path, optimizeOptions));
             if (it != modelMeshPtrs.end()) {
                 return it->second;
             }
             return emptyMeshVector;
         }
 
-        const std::vector<Rendering::Mesh*>& ResourceManager::LoadModelMeshes(const std::string& path)
+        const std::vector<Rendering::Mesh*>& ResourceManager::LoadModelMeshes(const std::string& path,
+            const Rendering::MeshOptimizeOptions& optimizeOptions)
         {
-            auto it = modelMeshPtrs.find(path);
+            std::string key = MakeModelKey(path, optimizeOptions);
+            auto it = modelMeshPtrs.find(key);
             if (it != modelMeshPtrs.end()) {
                 return it->second;
             }
 
-            std::vector<Rendering::Mesh*> loadedMeshes = Rendering::ModelLoader::LoadModel(path);
+            std::vector<Rendering::Mesh*> loadedMeshes = Rendering::ModelLoader::LoadModel(path, optimizeOptions);
 
             if (loadedMeshes.empty()) {
                 RTB_ERROR("ResourceManager: Failed to load model: " + path);
@@ -127,10 +159,38 @@ namespace RTBEngine {
                 ownedMeshes.push_back(std::unique_ptr<Rendering::Mesh>(mesh));
             }
 
-            modelMeshes[path] = std::move(ownedMeshes);
-            modelMeshPtrs[path] = meshPtrs;
+            modelMeshes[key] = std::move(ownedMeshes);
+            modelMeshPtrs[key] = meshPtrs;
+
+            return modelMeshPtrs[key];
+        }
+
+        bool ResourceManager::MaterialKey::operator<(const MaterialKey& other) const
+        {
+            return std::tie(shader, texture, color.x, color.y, color.z, color.w,
+                    diffuseColor.x, diffuseColor.y, diffuseColor.z, shininess)
+                < std::tie(other.shader, other.texture, other.color.x, other.color.y, other.color.z, other.color.w,
+                    other.diffuseColor.x, other.diffuseColor.y, other.diffuseColor.z, other.shininess);
+        }
+
+        Rendering::Material* ResourceManager::GetSharedMaterial(Rendering::Shader* shader, Rendering::Texture* texture,
+            const Math::Vector4& color, const Math::Vector3& diffuseColor, float shininess)
+        {
+            MaterialKey key{ shader, texture, color, diffuseColor, shininess };
+            auto it = materials.find(key);
+            if (it != materials.end()) {
+                return it->second.get();
+            }
+
+            auto material = std::make_unique<Rendering::Material>(shader);
+            material->SetTexture(texture);
+            material->SetColor(color);
+            material->SetDiffuseColor(diffuseColor);
+            material->SetShininess(shininess);
 
-            return modelMeshPtrs[path];
+            Rendering::Material* materialPtr = material.get();
+            materials[key] = std::move(material);
+            return materialPtr;
         }
 
         Audio::AudioClip* ResourceManager::GetAudioClip(const std::string& path)
@@ -171,6 +231,10 @@ namespace RTBEngine {
 
 		Rendering::Font* ResourceManager::LoadFont(const std::string& path, const float* sizes, int numSizes)
 		{
+			if (!Rendering::GraphicsContext::IsAvailable()) {
+				return nullptr;
+			}
+
 			auto existing = GetFont(path);
 			if (existing) {
 				return existing;
@@ -205,6 +269,10 @@ namespace RTBEngine {
         }
 
         Rendering::Cubemap* ResourceManager::LoadCubemap(const std::string& folderPath, const std::string& extension) {
+            if (!Rendering::GraphicsContext::IsAvailable()) {
+                return nullptr;
+            }
+
             // Check cache first
             auto existing = GetCubemap(folderPath);
             if (existing) {
@@ -249,6 +317,10 @@ namespace RTBEngine {
         }
 
         Rendering::Cubemap* ResourceManager::GetDefaultCubemap() {
+            if (!Rendering::GraphicsContext::IsAvailable()) {
+                return nullptr;
+            }
+
             // Check if already loaded
             auto existing = GetCubemap(DEFAULT_SKYBOX_PATH);
             if (existing) {
@@ -312,6 +384,7 @@ namespace RTBEngine {
             audioClips.clear();
 			fonts.clear();
             scenes.clear();
+            materials.clear();
 			defaultFont = nullptr;
             cubemaps.clear();
             defaultSkybox.reset();
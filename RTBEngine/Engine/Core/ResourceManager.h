@@ -2,6 +2,7 @@
 #include "../Rendering/Shader.h"
 #include "../Rendering/Texture.h"
 #include "../Rendering/Mesh.h"
+#include "../Rendering/Material.h"
 #include "../Rendering/ModelLoader.h"
 #include "../Rendering/Font.h"
 #include "../Audio/AudioClip.h"
@@ -9,6 +10,7 @@
 #include "../Rendering/Skybox.h"
 
 #include <unordered_map>
+#include <map>
 #include <string>
 #include <memory>
 
@@ -51,8 +53,19 @@ namespace RTBEngine {
             Rendering::Mesh* LoadModel(const std::string& path);
 
             // Model management (all meshes)
-            const std::vector<Rendering::Mesh*>& GetModelMeshes(const std::string& path);
-            const std::vector<Rendering::Mesh*>& LoadModelMeshes(const std::string& path);
+            // Meshes loaded with the given options (default options when omitted)
+            const std::vector<Rendering::Mesh*>& GetModelMeshes(const std::string& path,
+                const Rendering::MeshOptimizeOptions& optimizeOptions = Rendering::MeshOptimizeOptions());
+            // Cached per path and options: a model requested with different options is loaded again
+            const std::vector<Rendering::Mesh*>& LoadModelMeshes(const std::string& path,
+                const Rendering::MeshOptimizeOptions& optimizeOptions = Rendering::MeshOptimizeOptions());
+
+            // Material management. Returns the single material with this content, so renderers that look
+            // the same share one and the render queue can instance and multi-draw them together.
+            // Shared materials must not be edited; MeshRenderer copies its own before changing one.
+            Rendering::Material* GetSharedMaterial(Rendering::Shader* shader, Rendering::Texture* texture,
+                const Math::Vector4& color = Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f),
+                const Math::Vector3& diffuseColor = Math::Vector3(1.0f, 1.0f, 1.0f), float shininess = 32.0f);
 
             // Audio management
             Audio::AudioClip* GetAudioClip(const std::string& path);
@@ -93,6 +106,9 @@ namespace RTBEngine {
             std::unordered_map<std::string, std::unique_ptr<Audio::AudioClip>> audioClips;
             std::unordered_map<std::string, std::unique_ptr<Rendering::Cubemap>> cubemaps;
 
+            // Model caches are keyed by MakeModelKey
+            static std::string MakeModelKey(const std::string& path, const Rendering::MeshOptimizeOptions& optimizeOptions);
+
             // Cache for raw pointers (for GetModelMeshes return)
             std::unordered_map<std::string, std::vector<Rendering::Mesh*>> modelMeshPtrs;
             static std::vector<Rendering::Mesh*> emptyMeshVector;
@@ -101,6 +117,18 @@ namespace RTBEngine {
 			Rendering::Font* defaultFont = nullptr;
 
             std::unique_ptr<Rendering::Skybox> defaultSkybox;
+
+            // Everything Material uploads, so equal keys draw identically
+            struct MaterialKey {
+                Rendering::Shader* shader;
+                Rendering::Texture* texture;
+                Math::Vector4 color;
+                Math::Vector3 diffuseColor;
+                float shininess;
+
+                bool operator<(const MaterialKey& other) const;
+            };
+            std::map<MaterialKey, std::unique_ptr<Rendering::Material>> materials;
         };
 
     }
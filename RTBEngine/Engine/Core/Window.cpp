@@ -1,6 +1,7 @@
 #include "Window.h"
 #include <iostream>
 #include "../RTBEngine.h"
+#include "../Rendering/GLStateCache.h"
 
 RTBEngine::Core::Window::Window(const std::string& title, int width, int height, bool fullscreen, bool maximized) : title(title),
 width(width),
@@ -68,11 +69,13 @@ bool RTBEngine::Core::Window::Initialize()
 	}
 
 	// Enable OpenGL features
-	glEnable(GL_DEPTH_TEST);        // Enable depth testing
-	glDepthFunc(GL_LESS);            // Depth test passes if fragment is closer
-	glEnable(GL_CULL_FACE);          // Enable face culling
-	glCullFace(GL_BACK);             // Cull back faces
-	glFrontFace(GL_CCW);             // Front faces are counter-clockwise
+	Rendering::GLStateCache& state = Rendering::GLStateCache::GetInstance();
+	state.Invalidate();                 // New context; nothing tracked so far applies
+	state.SetDepthTest(true);           // Enable depth testing
+	state.SetDepthFunc(GL_LESS);        // Depth test passes if fragment is closer
+	state.SetCullFace(true);            // Enable face culling
+	state.SetCullMode(GL_BACK);         // Cull back faces
+	glFrontFace(GL_CCW);                // Front faces are counter-clockwise
 
 	SDL_GL_SetSwapInterval(1); // ENABLE V-SYNC
 
@@ -8,6 +8,7 @@ namespace RTBEngine {
 		RTB_REGISTER_COMPONENT(BoxColliderComponent)
 			RTB_PROPERTY(size)
 			RTB_PROPERTY(isTrigger)
+			RTB_ACCESS(OwnerOnly)
 		RTB_END_REGISTER(BoxColliderComponent)
 
 		BoxColliderComponent::BoxColliderComponent()
@@ -14,6 +14,7 @@ namespace RTBEngine {
             RTB_PROPERTY(orthographicSize)
             RTB_PROPERTY(syncWithTransform)
             RTB_PROPERTY(isMainCamera)
+            RTB_ACCESS(OwnerOnly)
         RTB_END_REGISTER(CameraComponent)
 
         CameraComponent::CameraComponent() {
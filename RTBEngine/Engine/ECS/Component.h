@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include "ComponentTypeId.h"
+#include "ComponentStorage.h"
 
 namespace RTBEngine {
     namespace Reflection {
@@ -51,6 +53,10 @@ namespace RTBEngine {
             // Returns type info for inspector. Components using RTB_COMPONENT override this.
             virtual const Reflection::TypeInfo* GetTypeInfo() const { return nullptr; }
 
+            // Type ids for GetComponent<T>(). Generated by RTB_COMPONENT / RTB_COMPONENT_TYPE.
+            virtual ComponentTypeId GetComponentTypeId() const { return InvalidComponentTypeId; }
+            virtual ComponentTypeId GetBaseComponentTypeId() const { return InvalidComponentTypeId; }
+
         protected:
             GameObject* owner;
             bool isEnabled;
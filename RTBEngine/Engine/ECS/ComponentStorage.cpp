@@ -0,0 +1,157 @@
+#include "ComponentStorage.h"
+#include <algorithm>
+#include <new>
+
+namespace RTBEngine {
+    namespace ECS {
+
+        ComponentPool::ComponentPool(size_t slotSize, size_t slotAlign, size_t slotsPerChunk)
+            : slotAlign(std::max(slotAlign, alignof(void*)))
+            , slotsPerChunk(std::max<size_t>(slotsPerChunk, 1))
+        {
+            // Slots double as free-list nodes, so they must hold a pointer
+            size_t size = std::max(slotSize, sizeof(void*));
+            this->slotSize = (size + this->slotAlign - 1) / this->slotAlign * this->slotAlign;
+        }
+
+        ComponentPool::~ComponentPool()
+        {
+            for (const Chunk& chunk : chunks) {
+                ::operator delete(reinterpret_cast<void*>(chunk.begin), std::align_val_t(slotAlign));
+            }
+            chunks.clear();
+        }
+
+        void* ComponentPool::Allocate()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (!freeList) {
+                AddChunk();
+            }
+
+            void* slot = freeList;
+            freeList = *static_cast<void**>(slot);
+            ++liveCount;
+            return slot;
+        }
+
+        bool ComponentPool::Deallocate(void* ptr)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+            auto it = std::upper_bound(chunks.begin(), chunks.end(), address,
+                [](uintptr_t value, const Chunk& chunk) { return value < chunk.begin; });
+            if (it == chunks.begin()) return false;
+            --it;
+            if (address >= it->end) return false;
+
+            *static_cast<void**>(ptr) = freeList;
+            freeList = ptr;
+            --liveCount;
+            return true;
+        }
+
+        void ComponentPool::AddChunk()
+        {
+            size_t bytes = slotSize * slotsPerChunk;
+            unsigned char* memory = static_cast<unsigned char*>(::operator new(bytes, std::align_val_t(slotAlign)));
+
+            Chunk chunk{ reinterpret_cast<uintptr_t>(memory), reinterpret_cast<uintptr_t>(memory) + bytes };
+            chunks.insert(std::upper_bound(chunks.begin(), chunks.end(), chunk,
+                [](const Chunk& a, const Chunk& b) { return a.begin < b.begin; }), chunk);
+
+            // Thread the free list front to back so new components fill the chunk in address order
+            for (size_t i = slotsPerChunk; i-- > 0;) {
+                void* slot = memory + i * slotSize;
+                *static_cast<void**>(slot) = freeList;
+                freeList = slot;
+            }
+        }
+
+        ComponentStorage& ComponentStorage::Get()
+        {
+            // Never destroyed: components owned by static singletons (ResourceManager scenes)
+            // can be released after this would otherwise have gone away
+            static ComponentStorage* instance = new ComponentStorage();
+            return *instance;
+        }
+
+        void ComponentStorage::SetPooled(bool enabled)
+        {
+            Get().pooled = enabled;
+        }
+
+        bool ComponentStorage::IsPooled()
+        {
+            return Get().pooled;
+        }
+
+        void ComponentStorage::SetSlotsPerChunk(size_t count)
+        {
+            Get().slotsPerChunk = std::max<size_t>(count, 1);
+        }
+
+        void* ComponentStorage::Allocate(ComponentTypeId typeId, size_t typeSize, size_t typeAlign, size_t requestedSize)
+        {
+            ComponentStorage& storage = Get();
+            if (!storage.pooled || requestedSize != typeSize) {
+                return ::operator new(requestedSize);
+            }
+
+            ComponentPool* pool = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(storage.poolsMutex);
+                if (typeId >= storage.pools.size()) {
+                    storage.pools.resize(typeId + 1, nullptr);
+                }
+                if (!storage.pools[typeId]) {
+                    storage.pools[typeId] = new ComponentPool(typeSize, typeAlign, storage.slotsPerChunk);
+                }
+                pool = storage.pools[typeId];
+            }
+
+            return pool->Allocate();
+        }
+
+        void ComponentStorage::Free(ComponentTypeId typeId, void* ptr)
+        {
+            if (!ptr) return;
+
+            // Pooling may have been toggled since allocation, so ask the pool whether it owns ptr
+            ComponentPool* pool = nullptr;
+            {
+                ComponentStorage& storage = Get();
+                std::lock_guard<std::mutex> lock(storage.poolsMutex);
+                if (typeId < storage.pools.size()) {
+                    pool = storage.pools[typeId];
+                }
+            }
+
+            if (!pool || !pool->Deallocate(ptr)) {
+                ::operator delete(ptr);
+            }
+        }
+
+        const ComponentPool* ComponentStorage::GetPool(ComponentTypeId typeId)
+        {
+            ComponentStorage& storage = Get();
+            std::lock_guard<std::mutex> lock(storage.poolsMutex);
+            return typeId < storage.pools.size() ? storage.pools[typeId] : nullptr;
+        }
+
+        void ComponentStorage::ReleasePools()
+        {
+            ComponentStorage& storage = Get();
+            std::lock_guard<std::mutex> lock(storage.poolsMutex);
+            for (ComponentPool*& pool : storage.pools) {
+                if (pool && pool->GetLiveCount() == 0) {
+                    delete pool;
+                    pool = nullptr;
+                }
+            }
+        }
+
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "ComponentTypeId.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+namespace RTBEngine {
+    namespace ECS {
+
+        // Fixed-size slot allocator. Slots of one component type are packed in contiguous chunks,
+        // so iterating a type touches a few blocks of memory instead of scattered heap nodes.
+        class ComponentPool {
+        public:
+            ComponentPool(size_t slotSize, size_t slotAlign, size_t slotsPerChunk);
+            ~ComponentPool();
+
+            ComponentPool(const ComponentPool&) = delete;
+            ComponentPool& operator=(const ComponentPool&) = delete;
+
+            void* Allocate();
+            // Returns false if the pointer was not allocated by this pool
+            bool Deallocate(void* ptr);
+
+            size_t GetSlotSize() const { return slotSize; }
+            size_t GetLiveCount() const { return liveCount; }
+            size_t GetChunkCount() const { return chunks.size(); }
+
+        private:
+            struct Chunk {
+                uintptr_t begin;
+                uintptr_t end;
+            };
+
+            void AddChunk();
+
+            size_t slotSize;
+            size_t slotAlign;
+            size_t slotsPerChunk;
+            std::vector<Chunk> chunks;  // Sorted by address
+            void* freeList = nullptr;
+            size_t liveCount = 0;
+            std::mutex mutex;
+        };
+
+        // Optional pooled storage for components. When enabled, components that declare a type id
+        // (RTB_COMPONENT / RTB_COMPONENT_TYPE) are allocated from a per-type ComponentPool and scene
+        // component lists are kept in memory order. Ownership and the GameObject API do not change.
+        class ComponentStorage {
+        public:
+            static void SetPooled(bool enabled);
+            static bool IsPooled();
+            static void SetSlotsPerChunk(size_t count);
+
+            static void* Allocate(ComponentTypeId typeId, size_t typeSize, size_t typeAlign, size_t requestedSize);
+            static void Free(ComponentTypeId typeId, void* ptr);
+
+            // Null until the first pooled allocation of that type
+            static const ComponentPool* GetPool(ComponentTypeId typeId);
+
+            // Frees every pool with no live components. Call on shutdown once scenes are destroyed;
+            // pools that still hold components are kept so their later Free calls stay valid.
+            static void ReleasePools();
+
+        private:
+            ComponentStorage() = default;
+            static ComponentStorage& Get();
+
+            std::vector<ComponentPool*> pools;  // Indexed by ComponentTypeId
+            std::mutex poolsMutex;
+            size_t slotsPerChunk = 256;
+            bool pooled = false;
+        };
+
+    }
+}
+
+// Routes allocation of a component class through ComponentStorage. Derived classes that do not
+// declare their own type id have a different size and fall back to the global heap.
+#define RTB_COMPONENT_STORAGE(ClassName)                                                \
+public:                                                                                 \
+    static void* operator new(std::size_t size) {                                       \
+        return RTBEngine::ECS::ComponentStorage::Allocate(ClassName::StaticComponentTypeId(), \
+            sizeof(ClassName), alignof(ClassName), size);                               \
+    }                                                                                   \
+    static void operator delete(void* ptr) {                                            \
+        RTBEngine::ECS::ComponentStorage::Free(ClassName::StaticComponentTypeId(), ptr); \
+    }                                                                                   \
+    static void* operator new(std::size_t, void* where) noexcept { return where; }     \
+    static void operator delete(void*, void*) noexcept {}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
+
+namespace RTBEngine {
+    namespace ECS {
+
+        // Dense per-type index used for O(1) component lookups (no RTTI)
+        using ComponentTypeId = uint32_t;
+        constexpr ComponentTypeId InvalidComponentTypeId = 0xFFFFFFFFu;
+
+        class ComponentTypeIds {
+        public:
+            // Hands out the next free id. Called once per type from RTB_COMPONENT_TYPE.
+            static ComponentTypeId Next() {
+                return Counter().fetch_add(1);
+            }
+
+            // Number of ids handed out so far
+            static ComponentTypeId GetCount() {
+                return Counter().load();
+            }
+
+        private:
+            static std::atomic<ComponentTypeId>& Counter() {
+                static std::atomic<ComponentTypeId> counter{ 0 };
+                return counter;
+            }
+        };
+
+        // True when T declares its own id (inherited ids from a base do not count)
+        template<typename T, typename = void>
+        struct HasComponentTypeId : std::false_type {};
+
+        template<typename T>
+        struct HasComponentTypeId<T, std::void_t<typename T::ComponentSelfType>>
+            : std::is_same<typename T::ComponentSelfType, T> {};
+
+    }
+}
+
+// Generates the static type id of a component and routes its allocation through
+// ComponentStorage. Included by RTB_COMPONENT; use it directly for components that are not reflected.
+#define RTB_COMPONENT_TYPE(ClassName)                                                   \
+public:                                                                                 \
+    using ComponentSelfType = ClassName;                                                \
+    static RTBEngine::ECS::ComponentTypeId StaticComponentTypeId() {                    \
+        static const RTBEngine::ECS::ComponentTypeId id = RTBEngine::ECS::ComponentTypeIds::Next(); \
+        return id;                                                                      \
+    }                                                                                   \
+    virtual RTBEngine::ECS::ComponentTypeId GetComponentTypeId() const override {       \
+        return ClassName::StaticComponentTypeId();                                      \
+    }                                                                                   \
+    RTB_COMPONENT_STORAGE(ClassName)                                                    \
+private:
+
+// For abstract component bases (e.g. UIElement): derived components are also found
+// through GetComponent<Base>().
+#define RTB_COMPONENT_BASE_TYPE(ClassName)                                              \
+public:                                                                                 \
+    using ComponentSelfType = ClassName;                                                \
+    static RTBEngine::ECS::ComponentTypeId StaticComponentTypeId() {                    \
+        static const RTBEngine::ECS::ComponentTypeId id = RTBEngine::ECS::ComponentTypeIds::Next(); \
+        return id;                                                                      \
+    }                                                                                   \
+    virtual RTBEngine::ECS::ComponentTypeId GetBaseComponentTypeId() const override {   \
+        return ClassName::StaticComponentTypeId();                                      \
+    }                                                                                   \
+private:
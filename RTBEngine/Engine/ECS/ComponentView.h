@@ -0,0 +1,42 @@
+#pragma once
+#include "Component.h"
+#include <vector>
+#include <cstddef>
+
+namespace RTBEngine {
+    namespace ECS {
+
+        // Typed, read-only range over one of the scene's per-type component lists.
+        // Components of inactive GameObjects and disabled components are included;
+        // systems filter them the same way they did when scanning GameObjects.
+        template<typename T>
+        class ComponentView {
+        public:
+            class Iterator {
+            public:
+                explicit Iterator(std::vector<Component*>::const_iterator it) : it(it) {}
+
+                T* operator*() const { return static_cast<T*>(*it); }
+                Iterator& operator++() { ++it; return *this; }
+                bool operator==(const Iterator& other) const { return it == other.it; }
+                bool operator!=(const Iterator& other) const { return it != other.it; }
+
+            private:
+                std::vector<Component*>::const_iterator it;
+            };
+
+            explicit ComponentView(const std::vector<Component*>& components) : components(components) {}
+
+            Iterator begin() const { return Iterator(components.begin()); }
+            Iterator end() const { return Iterator(components.end()); }
+
+            size_t Size() const { return components.size(); }
+            bool IsEmpty() const { return components.empty(); }
+            T* operator[](size_t index) const { return static_cast<T*>(components[index]); }
+
+        private:
+            const std::vector<Component*>& components;
+        };
+
+    }
+}
@@ -1,4 +1,6 @@
 #include "GameObject.h"
+#include "Scene.h"
+#include "../Reflection/TypeInfo.h"
 
 namespace RTBEngine {
     namespace ECS {
@@ -13,9 +15,17 @@ namespace RTBEngine {
 
         GameObject::~GameObject()
         {
+            SetScene(nullptr);
+            if (parent) {
+                parent->RemoveChild(this);
+            }
+            for (GameObject* child : children) {
+                child->parent = nullptr;
+            }
             for (auto& comp : components) {
                 comp->OnDestroy();
             }
+            componentSlots.clear();
             components.clear();
         }
 
@@ -24,6 +34,10 @@ namespace RTBEngine {
             if (component) {
                 component->SetOwner(this);
                 components.push_back(std::unique_ptr<Component>(component));
+                RegisterComponentSlots(component);
+                if (scene) {
+                    scene->RegisterComponent(component);
+                }
                 component->OnAwake();
             }
         }
@@ -36,50 +50,67 @@ namespace RTBEngine {
                 });
 
             if (it != components.end()) {
+                if (scene) {
+                    scene->UnregisterComponent(component);
+                }
                 (*it)->OnDestroy();
                 components.erase(it);
+                RebuildComponentSlots();
             }
         }
 
-        void GameObject::SetActive(bool active)
+        void GameObject::RegisterComponentSlots(Component* component)
         {
-            this->isActive = active;
-        }
+            const Reflection::TypeInfo* typeInfo = component->GetTypeInfo();
+            if (!typeInfo || !typeInfo->IsParallelUpdateSafe()) {
+                componentsParallelSafe = false;
+            }
 
-        Math::Matrix4 GameObject::GetWorldMatrix() const
-        {
-            if (parent) {
-                return parent->GetWorldMatrix() * transform.GetModelMatrix();
+            // Keep the first component of each type, matching the old scan order
+            const ComponentTypeId ids[] = { component->GetComponentTypeId(), component->GetBaseComponentTypeId() };
+            for (ComponentTypeId id : ids) {
+                if (id == InvalidComponentTypeId) continue;
+
+                if (id >= componentSlots.size()) {
+                    componentSlots.resize(id + 1, nullptr);
+                }
+                if (!componentSlots[id]) {
+                    componentSlots[id] = component;
+                }
             }
-            return transform.GetModelMatrix();
         }
 
-        Math::Vector3 GameObject::GetWorldPosition() const
+        void GameObject::RebuildComponentSlots()
         {
-            if (parent) {
-                // Return translation part of world matrix
-                Math::Matrix4 wm = GetWorldMatrix();
-                return Math::Vector3(wm[12], wm[13], wm[14]);
+            componentSlots.clear();
+            componentsParallelSafe = true;
+            for (auto& comp : components) {
+                RegisterComponentSlots(comp.get());
             }
-            return transform.GetPosition();
         }
 
-        Math::Quaternion GameObject::GetWorldRotation() const
+        void GameObject::SetActive(bool active)
         {
-            if (parent) {
-                return parent->GetWorldRotation() * transform.GetRotation();
-            }
-            return transform.GetRotation();
+            this->isActive = active;
         }
 
-        Math::Vector3 GameObject::GetWorldScale() const
+        void GameObject::SetScene(Scene* newScene)
         {
-            if (parent) {
-                Math::Vector3 parentScale = parent->GetWorldScale();
-                Math::Vector3 localScale = transform.GetScale();
-                return Math::Vector3(parentScale.x * localScale.x, parentScale.y * localScale.y, parentScale.z * localScale.z);
+            if (scene == newScene) return;
+
+            if (scene) {
+                for (auto& comp : components) {
+                    scene->UnregisterComponent(comp.get());
+                }
+            }
+
+            scene = newScene;
+
+            if (scene) {
+                for (auto& comp : components) {
+                    scene->RegisterComponent(comp.get());
+                }
             }
-            return transform.GetScale();
         }
 
         void GameObject::Update(float deltaTime)
@@ -129,6 +160,11 @@ namespace RTBEngine {
             if (parent) {
                 parent->AddChild(this);
             }
+
+            transform.SetParent(parent ? &parent->transform : nullptr);
+            if (scene) {
+                scene->MarkHierarchyDirty();
+            }
         }
 
         void GameObject::AddChild(GameObject* child)
@@ -10,6 +10,8 @@
 namespace RTBEngine {
     namespace ECS {
 
+        class Scene;
+
         class GameObject {
         public:
             GameObject(const std::string& name = "GameObject");
@@ -27,6 +29,11 @@ namespace RTBEngine {
             template<typename T>
             bool HasComponent();
 
+            // First component registered under the given type id (exact or base type)
+            Component* GetComponentById(ComponentTypeId typeId) const {
+                return typeId < componentSlots.size() ? componentSlots[typeId] : nullptr;
+            }
+
             const std::vector<std::unique_ptr<Component>>& GetComponents() const { return components; }
 
             Transform& GetTransform() { return transform; }
@@ -44,21 +51,38 @@ namespace RTBEngine {
             void SetActive(bool active);
             bool IsActive() const { return isActive; }
 
-            Math::Matrix4 GetWorldMatrix() const;
-            Math::Vector3 GetWorldPosition() const;
-            Math::Quaternion GetWorldRotation() const;
-            Math::Vector3 GetWorldScale() const;
+            // Owning scene, set by Scene::AddGameObject. Keeps the scene's component lists in sync.
+            void SetScene(Scene* newScene);
+            Scene* GetScene() const { return scene; }
+
+            // Cached by the Transform; see Transform::GetWorldMatrix
+            const Math::Matrix4& GetWorldMatrix() const { return transform.GetWorldMatrix(); }
+            Math::Vector3 GetWorldPosition() const { return transform.GetWorldPosition(); }
+            const Math::Quaternion& GetWorldRotation() const { return transform.GetWorldRotation(); }
+            const Math::Vector3& GetWorldScale() const { return transform.GetWorldScale(); }
+
+            // True when every component declared ComponentAccess::OwnerOnly and the object is a started,
+            // unparented leaf, so its update cannot touch any other GameObject
+            bool CanUpdateInParallel() const {
+                return componentsParallelSafe && started && !parent && children.empty();
+            }
 
             void Update(float deltaTime);
             void FixedUpdate(float fixedDeltaTime);
             void Render(Rendering::Camera* camera);
 
         private:
+            void RegisterComponentSlots(Component* component);
+            void RebuildComponentSlots();
+
             std::string name;
             Transform transform;
             std::vector<std::unique_ptr<Component>> components;
+            std::vector<Component*> componentSlots;  // Indexed by ComponentTypeId
+            bool componentsParallelSafe = true;
             bool isActive;
             bool started;
+            Scene* scene = nullptr;
 
             GameObject* parent = nullptr;
             std::vector<GameObject*> children;
@@ -67,13 +91,19 @@ namespace RTBEngine {
         template<typename T>
         T* GameObject::GetComponent()
         {
-            for (auto& comp : components) {
-                T* castedComp = dynamic_cast<T*>(comp.get());
-                if (castedComp != nullptr) {
-                    return castedComp;
+            if constexpr (HasComponentTypeId<T>::value) {
+                return static_cast<T*>(GetComponentById(T::StaticComponentTypeId()));
+            }
+            else {
+                // Types without an id (interfaces, legacy components) fall back to a scan
+                for (auto& comp : components) {
+                    T* castedComp = dynamic_cast<T*>(comp.get());
+                    if (castedComp != nullptr) {
+                        return castedComp;
+                    }
                 }
+                return nullptr;
             }
-            return nullptr;
         }
 
         template<typename T>
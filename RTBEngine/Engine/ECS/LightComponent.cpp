@@ -18,6 +18,7 @@ namespace RTBEngine {
             RTB_PROPERTY_RANGE(spotInnerAngle, 0.0f, 180.0f)
             RTB_PROPERTY(syncPosition)
             RTB_PROPERTY(syncDirection)
+            RTB_ACCESS(OwnerOnly)
         RTB_END_REGISTER(LightComponent)
 
         LightComponent::LightComponent()
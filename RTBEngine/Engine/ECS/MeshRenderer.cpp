@@ -3,26 +3,39 @@
 #include "../Rendering/Lighting/Light.h"
 #include "../Rendering/Lighting/DirectionalLight.h"
 #include "../Animation/Animator.h"
+#include "../Core/ResourceManager.h"
 #include "../Reflection/PropertyMacros.h"
+#include <algorithm>
+#include <cmath>
 
 namespace RTBEngine {
     namespace ECS {
 
+        // Levels of one mesh sort next to each other but never into the same instance run
+        static uint32_t GetLodSortId(const Rendering::Mesh& mesh, uint32_t lod)
+        {
+            return mesh.GetSortId() * Rendering::Mesh::MAX_LODS + lod;
+        }
+
         using ThisClass = MeshRenderer;
         RTB_REGISTER_COMPONENT(MeshRenderer)
             RTB_PROPERTY_MESH(meshRef)
             RTB_PROPERTY_TEXTURE(textureRef)
             RTB_PROPERTY_COLOR(colorRef)
+            RTB_PROPERTY(isStatic)
+            RTB_PROPERTY(lodBias)
+            RTB_PROPERTY(lodHysteresis)
+            RTB_PROPERTY(shadowLodOffset)
+            RTB_PROPERTY(isOccluder)
+            RTB_ACCESS(OwnerOnly)
         RTB_END_REGISTER(MeshRenderer)
 
         MeshRenderer::MeshRenderer()
             : Component()
         {
-            material = std::make_unique<Rendering::Material>(nullptr);
             // Default material values
-            if (material) {
-                colorRef = material->GetColor();
-            }
+            material = Core::ResourceManager::GetInstance().GetSharedMaterial(nullptr, nullptr);
+            colorRef = material->GetColor();
         }
 
         MeshRenderer::~MeshRenderer()
@@ -50,16 +63,37 @@ namespace RTBEngine {
                 }
             }
 
-            // Material
-            if (material) {
-                if (material->GetTexture() != textureRef) {
-                    material->SetTexture(textureRef);
-                }
-                
-                // Approximate color check to avoid per-frame uniform setting if costly?
-                // Material::SetColor usually just sets member, uniform set on Bind.
-                material->SetColor(colorRef);
+            // Material. May run on a worker, so edits go to a private copy instead of through the cache.
+            if (material->GetTexture() != textureRef || material->GetColor() != colorRef) {
+                Rendering::Material* unique = GetUniqueMaterial();
+                unique->SetTexture(textureRef);
+                unique->SetColor(colorRef);
+            }
+        }
+
+        Rendering::Material* MeshRenderer::GetUniqueMaterial()
+        {
+            if (!ownedMaterial) {
+                ownedMaterial = std::make_unique<Rendering::Material>(material->GetShader());
+                ownedMaterial->SetTexture(material->GetTexture());
+                ownedMaterial->SetColor(material->GetColor());
+                ownedMaterial->SetDiffuseColor(material->GetDiffuseColor());
+                ownedMaterial->SetShininess(material->GetShininess());
+                material = ownedMaterial.get();
             }
+            return ownedMaterial.get();
+        }
+
+        void MeshRenderer::SetMaterialState(Rendering::Shader* shader, Rendering::Texture* texture, const Math::Vector4& color)
+        {
+            if (ownedMaterial) {
+                ownedMaterial->SetShader(shader);
+                ownedMaterial->SetTexture(texture);
+                ownedMaterial->SetColor(color);
+                return;
+            }
+            material = Core::ResourceManager::GetInstance().GetSharedMaterial(shader, texture, color,
+                material->GetDiffuseColor(), material->GetShininess());
         }
 
         void MeshRenderer::SetMesh(Rendering::Mesh* mesh)
@@ -91,75 +125,182 @@ namespace RTBEngine {
             if (meshIndex < meshMaterials.size() && meshMaterials[meshIndex]) {
                 return meshMaterials[meshIndex];
             }
-            return material.get();
+            return material;
         }
 
         void MeshRenderer::SetTexture(Rendering::Texture* tex) {
-            if (material) {
-                material->SetTexture(tex);
-                textureRef = tex; // Keep synced
-            }
+            SetMaterialState(material->GetShader(), tex, material->GetColor());
+            textureRef = tex; // Keep synced
         }
 
         void MeshRenderer::SetShader(Rendering::Shader* shader) {
-            if (material) {
-                material->SetShader(shader);
+            SetMaterialState(shader, material->GetTexture(), material->GetColor());
+        }
+
+
+        Math::AABB MeshRenderer::GetWorldBounds() const
+        {
+            Math::AABB localBounds;
+            for (Rendering::Mesh* mesh : meshes) {
+                if (mesh) {
+                    localBounds.Expand(mesh->GetBounds());
+                }
+            }
+            if (localBounds.IsEmpty() || !owner) {
+                return localBounds;
+            }
+
+            Animation::Animator* animator = owner->GetComponent<Animation::Animator>();
+            if (animator && animator->HasBones()) {
+                // A skinned vertex is a weighted blend of bone-transformed bind positions, so it stays
+                // inside the union of the bind box under each bone (the bind box itself covers unweighted vertices)
+                Math::AABB skinnedBounds = localBounds;
+                for (const Math::Matrix4& bone : animator->GetBoneTransforms()) {
+                    skinnedBounds.Expand(localBounds.Transformed(bone));
+                }
+                localBounds = skinnedBounds;
+            }
+
+            return localBounds.Transformed(owner->GetWorldMatrix());
+        }
+
+        bool MeshRenderer::IsStaticShadowCaster() const
+        {
+            return isStatic && owner && !owner->GetComponent<Animation::Animator>();
+        }
+
+        bool MeshRenderer::IsOccluder() const
+        {
+            return isOccluder && owner && !owner->GetComponent<Animation::Animator>();
+        }
+
+        void MeshRenderer::SubmitOccluder(Rendering::OcclusionCuller& culler) const
+        {
+            if (!owner) return;
+
+            const Math::Matrix4& worldMatrix = owner->GetWorldMatrix();
+            if (occluderMesh) {
+                occluderMesh->BuildOccluderGeometry();
+                culler.AddOccluder(occluderMesh->GetOccluderPositions(), occluderMesh->GetOccluderIndices(), worldMatrix);
+                return;
+            }
+
+            for (Rendering::Mesh* mesh : meshes) {
+                if (mesh) {
+                    mesh->BuildOccluderGeometry();
+                    culler.AddOccluder(mesh->GetOccluderPositions(), mesh->GetOccluderIndices(), worldMatrix);
+                }
             }
         }
 
+        uint32_t MeshRenderer::SelectLod(const Rendering::Camera& camera, const Math::AABB& worldBounds)
+        {
+            // Thresholds come from the mesh with the longest LOD chain; the others clamp to their own
+            const Rendering::Mesh* lodSource = nullptr;
+            for (Rendering::Mesh* mesh : meshes) {
+                if (mesh && (!lodSource || mesh->GetLodCount() > lodSource->GetLodCount())) {
+                    lodSource = mesh;
+                }
+            }
+            if (!lodSource || lodSource->GetLodCount() <= 1 || worldBounds.IsEmpty()) {
+                currentLod = 0;
+                return currentLod;
+            }
+
+            // Projected height of the bounding sphere as a fraction of the screen height
+            float radius = worldBounds.GetExtents().Length();
+            float screenSize = 1.0f;
+            if (camera.GetProjectionType() == Rendering::ProjectionType::Orthographic) {
+                if (camera.GetOrthographicSize() > 0.0f) {
+                    screenSize = 2.0f * radius / camera.GetOrthographicSize();
+                }
+            }
+            else {
+                const float toRadians = 3.14159265f / 180.0f;
+                float distance = (worldBounds.GetCenter() - camera.GetPosition()).Length();
+                float tanHalfFov = std::tan(camera.GetFOV() * 0.5f * toRadians);
+                if (distance > radius && tanHalfFov > 0.0f) {
+                    screenSize = radius / (distance * tanHalfFov);
+                }
+            }
+            screenSize *= lodBias;
+
+            uint32_t lodCount = lodSource->GetLodCount();
+            currentLod = std::min(currentLod, lodCount - 1);
+            while (currentLod + 1 < lodCount
+                && screenSize < lodSource->GetLod(currentLod + 1).screenSize * (1.0f - lodHysteresis)) {
+                currentLod++;
+            }
+            while (currentLod > 0
+                && screenSize > lodSource->GetLod(currentLod).screenSize * (1.0f + lodHysteresis)) {
+                currentLod--;
+            }
+            return currentLod;
+        }
 
-        void MeshRenderer::Render(Rendering::Camera* camera, const std::vector<Rendering::Light*>& lights)
+        void MeshRenderer::Submit(Rendering::RenderQueue& queue, const Rendering::Camera& camera, const Math::AABB& worldBounds)
         {
             if (!isEnabled || meshes.empty() || !owner) {
                 return;
             }
 
-            // Get common data
-            Math::Matrix4 modelMatrix = owner->GetWorldMatrix();
+            uint32_t lod = SelectLod(camera, worldBounds);
+
+            const Math::Matrix4& modelMatrix = owner->GetWorldMatrix();
             Animation::Animator* animator = owner->GetComponent<Animation::Animator>();
+            int32_t boneOffset = animator ? animator->GetPaletteOffset() : -1;
+
+            float distance = (owner->GetWorldPosition() - camera.GetPosition()).Length();
+            float normalizedDepth = camera.GetFarPlane() > 0.0f ? distance / camera.GetFarPlane() : 0.0f;
 
-            // Draw each mesh with its material
             for (size_t i = 0; i < meshes.size(); i++) {
                 Rendering::Mesh* mesh = meshes[i];
                 if (!mesh) continue;
 
-                // Get material for this mesh
                 Rendering::Material* mat = GetMeshMaterial(i);
-                if (!mat) continue;
-
-                mat->Bind();
-
-                Rendering::Shader* shader = mat->GetShader();
-                if (shader) {
-                    shader->SetMatrix4("uModel", modelMatrix);
-                    shader->SetMatrix4("uView", camera->GetViewMatrix());
-                    shader->SetMatrix4("uProjection", camera->GetProjectionMatrix());
-                    shader->SetVector3("uViewPos", camera->GetPosition());
-
-                    // Skeletal animation
-                    if (animator && animator->HasBones()) {
-                        shader->SetBool("uHasAnimation", true);
-                        const std::vector<Math::Matrix4>& boneTransforms = animator->GetBoneTransforms();
-                        for (size_t j = 0; j < boneTransforms.size() && j < 100; j++) {
-                            shader->SetMatrix4("uBoneTransforms[" + std::to_string(j) + "]", boneTransforms[j]);
-                        }
-                    }
-                    else {
-                        shader->SetBool("uHasAnimation", false);
-                    }
-
-                    // Lighting
-                    if (!lights.empty()) {
-                        lights[0]->ApplyToShader(shader);
-                    }
-                    else {
-                        shader->SetVector3("uLightDir", Math::Vector3(0.0f, -1.0f, 0.0f));
-                        shader->SetVector3("uLightColor", Math::Vector3(1.0f, 1.0f, 1.0f));
-                    }
-                }
+                if (!mat || !mat->GetShader()) continue;
+
+                Rendering::Texture* texture = mat->GetTexture();
+
+                Rendering::DrawItem item;
+                item.mesh = mesh;
+                item.material = mat;
+                item.modelMatrix = &modelMatrix;
+                // Meshes without bone attributes draw unskinned even under an Animator
+                item.boneOffset = mesh->GetVertexLayout() == Rendering::VertexLayout::Skinned ? boneOffset : -1;
+                item.lod = std::min(lod, mesh->GetLodCount() - 1);
+                item.sortKey = Rendering::RenderQueue::MakeSortKey(0, mat->GetShader()->GetProgramID(),
+                    texture ? texture->GetID() : 0, mat->GetSortId(), GetLodSortId(*mesh, item.lod), normalizedDepth);
+                queue.Submit(item);
+            }
+        }
+
+        void MeshRenderer::SubmitDepth(Rendering::RenderQueue& queue)
+        {
+            if (meshes.empty() || !owner) {
+                return;
+            }
+
+            Animation::Animator* animator = owner->GetComponent<Animation::Animator>();
+
+            int32_t boneOffset = animator ? animator->GetPaletteOffset() : -1;
+
+            // Shadow maps are drawn before the geometry pass, so dynamic casters use last frame's level.
+            // Cached static casters ignore the camera; a camera-driven level would stale their cascades.
+            uint32_t offset = static_cast<uint32_t>(std::max(shadowLodOffset, 0));
+            uint32_t lod = IsStaticShadowCaster() ? offset : currentLod + offset;
+
+            Rendering::DrawItem item;
+            item.modelMatrix = &owner->GetWorldMatrix();
+
+            for (Rendering::Mesh* mesh : meshes) {
+                if (!mesh) continue;
 
-                mesh->Draw();
-                mat->Unbind();
+                item.mesh = mesh;
+                item.boneOffset = mesh->GetVertexLayout() == Rendering::VertexLayout::Skinned ? boneOffset : -1;
+                item.lod = std::min(lod, mesh->GetLodCount() - 1);
+                item.sortKey = Rendering::RenderQueue::MakeSortKey(0, 0, 0, 0, GetLodSortId(*mesh, item.lod), 0.0f);
+                queue.Submit(item);
             }
         }
 
@@ -4,6 +4,9 @@
 #include "../Rendering/Mesh.h"
 #include "../Rendering/Material.h"
 #include "../Rendering/Camera.h"
+#include "../Rendering/RenderQueue.h"
+#include "../Rendering/OcclusionCuller.h"
+#include "../Math/Geometry/AABB.h"
 #include <vector>
 #include <memory>
 
@@ -26,7 +29,11 @@ namespace RTBEngine {
 
             Rendering::Mesh* GetMesh() const { return meshes.empty() ? nullptr : meshes[0]; }
             const std::vector<Rendering::Mesh*>& GetMeshes() const { return meshes; }
-            Rendering::Material* GetMaterial() const { return material.get(); }
+            // Shared with every renderer that looks the same until this one is edited; read-only.
+            // Change it through the setters and reflected properties, or edit GetUniqueMaterial.
+            Rendering::Material* GetMaterial() const { return material; }
+            // This renderer's own material, copied from the shared one on first use
+            Rendering::Material* GetUniqueMaterial();
 
             // Per-mesh materials (from model file)
             void SetMeshMaterials(const std::vector<Rendering::Material*>& mats);
@@ -36,10 +43,45 @@ namespace RTBEngine {
             void SetTexture(Rendering::Texture* tex);
             void SetShader(Rendering::Shader* shader);
 
-            void Render(Rendering::Camera* camera, const std::vector<Rendering::Light*>& lights);
+            // Records one draw item per mesh; the queue sorts and issues them. Picks this frame's
+            // detail level from worldBounds (as returned by GetWorldBounds) projected by camera.
+            void Submit(Rendering::RenderQueue& queue, const Rendering::Camera& camera, const Math::AABB& worldBounds);
+            // Same for depth-only passes, keyed by mesh so shadow casters instance too. Uses the level
+            // last picked by Submit plus shadowLodOffset.
+            void SubmitDepth(Rendering::RenderQueue& queue);
+
+            uint32_t GetCurrentLod() const { return currentLod; }
+
+            // World-space bounds of all meshes, from the cached world matrix. Skinned meshes use the
+            // bind-pose box moved by every bone, which is conservative for any current pose.
+            Math::AABB GetWorldBounds() const;
+
+            // Static renderers neither move nor animate, so their shadows can be cached across frames
+            bool IsStaticShadowCaster() const;
+
+            // Skinned renderers never occlude: the culler only sees bind-pose positions
+            bool IsOccluder() const;
+            // Queues occluderMesh, or the coarsest level of every mesh, into the occlusion buffer
+            void SubmitOccluder(Rendering::OcclusionCuller& culler) const;
 
             virtual void OnUpdate(float deltaTime) override;
 
+            // Marks the object as never moving; moving it anyway only costs a shadow cache rebuild
+            bool isStatic = false;
+
+            // LOD n is drawn once the projected height of the bounds (fraction of the screen height,
+            // times lodBias) drops below the mesh's screen size for n. Each threshold is widened by
+            // lodHysteresis towards the current level so objects near one do not flicker.
+            float lodBias = 1.0f;
+            float lodHysteresis = 0.1f;
+            // Levels coarser than the main pass drawn into shadow maps
+            int shadowLodOffset = 1;
+
+            // Hides renderers behind it from the main pass; meant for large, solid, opaque objects
+            bool isOccluder = false;
+            // Optional simplified stand-in rasterized instead of the renderer's own meshes
+            Rendering::Mesh* occluderMesh = nullptr;
+
             // Reflected properties (Proxy)
             Rendering::Mesh* meshRef = nullptr;
             Rendering::Texture* textureRef = nullptr;
@@ -49,10 +91,16 @@ namespace RTBEngine {
 
         private:
             std::vector<Rendering::Mesh*> meshes;
-            std::unique_ptr<Rendering::Material> material;
+            Rendering::Material* material = nullptr;              // Shared (ResourceManager) or ownedMaterial
+            std::unique_ptr<Rendering::Material> ownedMaterial;  // Set once this renderer diverges
             std::vector<Rendering::Material*> meshMaterials;  // Per-mesh materials (not owned)
+            uint32_t currentLod = 0;
+
+            uint32_t SelectLod(const Rendering::Camera& camera, const Math::AABB& worldBounds);
             
             void SyncProperties();
+            // Switches to the shared material with this content, or edits ownedMaterial once there is one
+            void SetMaterialState(Rendering::Shader* shader, Rendering::Texture* texture, const Math::Vector4& color);
         };
 
     }
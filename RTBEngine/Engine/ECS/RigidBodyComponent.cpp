@@ -10,6 +10,7 @@ namespace RTBEngine {
             RTB_PROPERTY(friction)
             RTB_PROPERTY(restitution)
             RTB_PROPERTY_ENUM(type, "Static", "Dynamic", "Kinematic")
+            RTB_ACCESS(OwnerOnly)
         RTB_END_REGISTER(RigidBodyComponent)
 
         RigidBodyComponent::RigidBodyComponent()
@@ -1,9 +1,15 @@
 #include "Scene.h"
 #include <algorithm>
+#include <functional>
 
 #include "GameObject.h"
 #include "MeshRenderer.h"
 #include "CameraComponent.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Profiler.h"
+#include "../Math/Geometry/Frustum.h"
+
+const std::vector<RTBEngine::ECS::Component*> RTBEngine::ECS::Scene::emptyComponentList;
 
 RTBEngine::ECS::Scene::Scene(const std::string& name) : name(name)
 {
@@ -11,12 +17,20 @@ RTBEngine::ECS::Scene::Scene(const std::string& name) : name(name)
 
 RTBEngine::ECS::Scene::~Scene()
 {
+	// Drop the lists first so destroying objects does not unregister one by one
+	componentsByType.clear();
+	componentListUnsorted.clear();
+	for (auto& gameObject : gameObjects) {
+		gameObject->SetScene(nullptr);
+	}
 	gameObjects.clear();
 }
 
 void RTBEngine::ECS::Scene::AddGameObject(GameObject* gameObject)
 {
 	gameObjects.push_back(std::unique_ptr<GameObject>(gameObject));
+	gameObject->SetScene(this);
+	hierarchyDirty = true;
 }
 
 void RTBEngine::ECS::Scene::RemoveGameObject(GameObject* gameObject)
@@ -27,7 +41,70 @@ void RTBEngine::ECS::Scene::RemoveGameObject(GameObject* gameObject)
 		});
 
 	if (it != gameObjects.end()) {
+		(*it)->SetScene(nullptr);
 		gameObjects.erase(it);
+		hierarchyDirty = true;
+	}
+}
+
+void RTBEngine::ECS::Scene::RegisterComponent(Component* component)
+{
+	if (!component) return;
+
+	ComponentTypeId ids[2] = { component->GetComponentTypeId(), component->GetBaseComponentTypeId() };
+	for (ComponentTypeId id : ids) {
+		if (id == InvalidComponentTypeId) continue;
+		if (id >= componentsByType.size()) {
+			componentsByType.resize(id + 1);
+			componentListUnsorted.resize(id + 1, false);
+		}
+
+		// Pooled lists are put back in address order on the next View, so loading stays linear
+		componentsByType[id].push_back(component);
+		if (ComponentStorage::IsPooled()) {
+			componentListUnsorted[id] = true;
+		}
+	}
+}
+
+const std::vector<RTBEngine::ECS::Component*>& RTBEngine::ECS::Scene::GetComponentList(ComponentTypeId id) const
+{
+	if (id >= componentsByType.size()) {
+		return emptyComponentList;
+	}
+
+	auto& list = componentsByType[id];
+	if (componentListUnsorted[id]) {
+		// Address order lets views walk the pool chunks linearly
+		std::sort(list.begin(), list.end(), std::less<Component*>());
+		componentListUnsorted[id] = false;
+	}
+	return list;
+}
+
+void RTBEngine::ECS::Scene::SortComponentLists()
+{
+	for (ComponentTypeId id = 0; id < componentsByType.size(); ++id) {
+		GetComponentList(id);
+	}
+}
+
+void RTBEngine::ECS::Scene::UnregisterComponent(Component* component)
+{
+	if (!component) return;
+
+	if (component == mainCamera) {
+		mainCamera = nullptr;
+	}
+
+	ComponentTypeId ids[2] = { component->GetComponentTypeId(), component->GetBaseComponentTypeId() };
+	for (ComponentTypeId id : ids) {
+		if (id >= componentsByType.size()) continue;
+		auto& list = componentsByType[id];
+		auto it = std::find(list.begin(), list.end(), component);
+		if (it != list.end()) {
+			list.erase(it);
+		}
 	}
 }
 
@@ -47,32 +124,176 @@ RTBEngine::ECS::GameObject* RTBEngine::ECS::Scene::FindGameObject(const std::str
 
 void RTBEngine::ECS::Scene::Update(float deltaTime)
 {
-	for (auto& gameObject : gameObjects) {
+	RTB_PROFILE_SCOPE("Scene::Update");
+
+	// Sort here rather than inside a View called from a worker
+	SortComponentLists();
+
+	Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+	if (!parallelUpdateEnabled || jobs.GetWorkerCount() == 0) {
+		for (auto& gameObject : gameObjects) {
+			gameObject->Update(deltaTime);
+		}
+		return;
+	}
+
+	SplitUpdateBatches();
+
+	jobs.ParallelFor(parallelBatch.size(), PARALLEL_UPDATE_GRAIN, [this, deltaTime](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			parallelBatch[i]->Update(deltaTime);
+		}
+	});
+
+	for (GameObject* gameObject : serialBatch) {
 		gameObject->Update(deltaTime);
 	}
 }
 
 void RTBEngine::ECS::Scene::FixedUpdate(float fixedDeltaTime)
 {
-    for (auto& gameObject : gameObjects) {
-        gameObject->FixedUpdate(fixedDeltaTime);
-    }
+	SortComponentLists();
+
+	Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+	if (!parallelUpdateEnabled || jobs.GetWorkerCount() == 0) {
+		for (auto& gameObject : gameObjects) {
+			gameObject->FixedUpdate(fixedDeltaTime);
+		}
+		return;
+	}
+
+	SplitUpdateBatches();
+
+	jobs.ParallelFor(parallelBatch.size(), PARALLEL_UPDATE_GRAIN, [this, fixedDeltaTime](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			parallelBatch[i]->FixedUpdate(fixedDeltaTime);
+		}
+	});
+
+	for (GameObject* gameObject : serialBatch) {
+		gameObject->FixedUpdate(fixedDeltaTime);
+	}
 }
 
-void RTBEngine::ECS::Scene::Render(Rendering::Camera* camera)
+void RTBEngine::ECS::Scene::SplitUpdateBatches()
 {
-	if (!camera) return;
-
-	CollectLights();
+	parallelBatch.clear();
+	serialBatch.clear();
 
 	for (auto& gameObject : gameObjects) {
-		if (gameObject->IsActive()) {
-			MeshRenderer* renderer = gameObject->GetComponent<MeshRenderer>();
-			if (renderer && renderer->IsEnabled()) {
-				renderer->Render(camera, lights);
+		if (gameObject->IsActive() && gameObject->CanUpdateInParallel()) {
+			parallelBatch.push_back(gameObject.get());
+		}
+		else {
+			serialBatch.push_back(gameObject.get());
+		}
+	}
+}
+
+void RTBEngine::ECS::Scene::UpdateTransforms()
+{
+	RTB_PROFILE_SCOPE("Scene::UpdateTransforms");
+
+	if (hierarchyDirty) {
+		transformOrder.clear();
+		transformOrder.reserve(gameObjects.size());
+
+		for (auto& gameObject : gameObjects) {
+			if (!gameObject->GetTransform().GetParent()) {
+				transformOrder.push_back(&gameObject->GetTransform());
 			}
 		}
+
+		// Breadth-first: every transform is appended after its parent
+		for (size_t i = 0; i < transformOrder.size(); ++i) {
+			for (Transform* child : transformOrder[i]->GetChildren()) {
+				transformOrder.push_back(child);
+			}
+		}
+
+		hierarchyDirty = false;
+	}
+
+	for (Transform* transform : transformOrder) {
+		transform->UpdateWorld();
+	}
+}
+
+void RTBEngine::ECS::Scene::Render(Rendering::Camera* camera, Rendering::RenderPassStats* stats)
+{
+	if (!camera) return;
+
+	Math::Matrix4 viewProjection = camera->GetViewProjectionMatrix();
+	Math::Frustum frustum(viewProjection);
+
+	renderQueue.Clear();
+
+	if (occlusionCullingEnabled) {
+		RasterizeOccluders(viewProjection, frustum);
+	}
+
+	for (MeshRenderer* renderer : View<MeshRenderer>()) {
+		if (!renderer->IsEnabled() || !renderer->GetOwner()->IsActive()) continue;
+
+		Math::AABB bounds = renderer->GetWorldBounds();
+		if (!frustum.Intersects(bounds)) {
+			if (stats) stats->culled++;
+			continue;
+		}
+
+		// Occluders rasterized this frame would only be tested against themselves
+		if (occlusionCullingEnabled && !renderer->IsOccluder() && !occlusionCuller.IsVisible(bounds)) {
+			if (stats) stats->occluded++;
+			continue;
+		}
+
+		renderer->Submit(renderQueue, *camera, bounds);
+		if (stats) stats->drawn++;
 	}
+
+	renderQueue.Sort();
+	renderQueue.Execute(stats);
+}
+
+void RTBEngine::ECS::Scene::RasterizeOccluders(const Math::Matrix4& viewProjection, const Math::Frustum& frustum)
+{
+	RTB_PROFILE_SCOPE("Scene::RasterizeOccluders");
+
+	occlusionCuller.BeginFrame(viewProjection);
+
+	for (MeshRenderer* renderer : View<MeshRenderer>()) {
+		if (!renderer->IsEnabled() || !renderer->GetOwner()->IsActive() || !renderer->IsOccluder()) continue;
+		if (!frustum.Intersects(renderer->GetWorldBounds())) continue;
+
+		renderer->SubmitOccluder(occlusionCuller);
+	}
+
+	occlusionCuller.Rasterize();
+}
+
+uint64_t RTBEngine::ECS::Scene::ComputeStaticShadowSignature()
+{
+	// FNV-1a over the raw bytes; a few dozen bytes per static object is cheap next to drawing it
+	uint64_t hash = 14695981039346656037ull;
+	auto mix = [&hash](const void* data, size_t size) {
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+	};
+
+	for (MeshRenderer* renderer : View<MeshRenderer>()) {
+		if (!renderer->IsEnabled() || !renderer->GetOwner()->IsActive() || !renderer->IsStaticShadowCaster()) continue;
+
+		mix(&renderer, sizeof(renderer));
+		mix(&renderer->shadowLodOffset, sizeof(renderer->shadowLodOffset));
+		for (Rendering::Mesh* mesh : renderer->GetMeshes()) {
+			mix(&mesh, sizeof(mesh));
+		}
+		mix(renderer->GetOwner()->GetWorldMatrix().m, sizeof(float) * 16);
+	}
+
+	return hash;
 }
 
 void RTBEngine::ECS::Scene::SetSkyboxCubemap(Rendering::Cubemap* cubemap) {
@@ -83,12 +304,9 @@ void RTBEngine::ECS::Scene::CollectLights()
 {
 	lights.clear();
 
-	for (auto& gameObject : gameObjects) {
-		if (gameObject->IsActive()) {
-			LightComponent* lightComp = gameObject->GetComponent<LightComponent>();
-			if (lightComp && lightComp->IsEnabled()) {
-				lights.push_back(lightComp->GetLight());
-			}
+	for (LightComponent* lightComp : View<LightComponent>()) {
+		if (lightComp->IsEnabled() && lightComp->GetOwner()->IsActive()) {
+			lights.push_back(lightComp->GetLight());
 		}
 	}
 }
@@ -108,24 +326,18 @@ RTBEngine::Rendering::Camera* RTBEngine::ECS::Scene::GetActiveCamera() {
 	}
 
 	// Otherwise, find first CameraComponent marked as main 
-	for (auto& go : gameObjects) {
-		if (go->IsActive()) {
-			CameraComponent* camComp = go->GetComponent<CameraComponent>();
-			if (camComp && camComp->IsMain() && camComp->GetCamera()) {
-				mainCamera = camComp;
-				return camComp->GetCamera();
-			}
+	for (CameraComponent* camComp : View<CameraComponent>()) {
+		if (camComp->GetOwner()->IsActive() && camComp->IsMain() && camComp->GetCamera()) {
+			mainCamera = camComp;
+			return camComp->GetCamera();
 		}
 	}
 
 	// If no main camera, find any CameraComponent
-	for (auto& go : gameObjects) {
-		if (go->IsActive()) {
-			CameraComponent* camComp = go->GetComponent<CameraComponent>();
-			if (camComp && camComp->GetCamera()) {
-				mainCamera = camComp;
-				return camComp->GetCamera();
-			}
+	for (CameraComponent* camComp : View<CameraComponent>()) {
+		if (camComp->GetOwner()->IsActive() && camComp->GetCamera()) {
+			mainCamera = camComp;
+			return camComp->GetCamera();
 		}
 	}
 
@@ -3,6 +3,11 @@
 #include "../Rendering/Camera.h"
 #include "../Rendering/Lighting/Light.h"
 #include "LightComponent.h"
+#include "ComponentView.h"
+#include "../Rendering/RenderStats.h"
+#include "../Rendering/RenderQueue.h"
+#include "../Rendering/OcclusionCuller.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -33,7 +38,28 @@ namespace RTBEngine {
 
             void Update(float deltaTime);
             void FixedUpdate(float fixedDeltaTime);
-            void Render(Rendering::Camera* camera);
+            // Draws every visible MeshRenderer whose world bounds intersect the camera frustum,
+            // sorted through the render queue to minimise state changes. Camera and light uniform
+            // blocks must already be up to date. With occlusion culling on, occluders are rasterized
+            // first and renderers hidden behind them are skipped.
+            void Render(Rendering::Camera* camera, Rendering::RenderPassStats* stats = nullptr);
+
+            void SetOcclusionCullingEnabled(bool enabled) { occlusionCullingEnabled = enabled; }
+            bool IsOcclusionCullingEnabled() const { return occlusionCullingEnabled; }
+            Rendering::OcclusionCuller& GetOcclusionCuller() { return occlusionCuller; }
+
+            // Hash over every active static shadow caster's meshes and world matrix. Changes whenever
+            // one is added, removed, toggled, re-meshed or moved, i.e. when cached static shadows are stale.
+            uint64_t ComputeStaticShadowSignature();
+
+            // Update/FixedUpdate run parallel-safe objects on the JobSystem workers first, then the rest
+            // on the calling thread. See GameObject::CanUpdateInParallel.
+            void SetParallelUpdateEnabled(bool enabled) { parallelUpdateEnabled = enabled; }
+            bool IsParallelUpdateEnabled() const { return parallelUpdateEnabled; }
+
+            // Refreshes dirty world matrices once per frame, parents before children
+            void UpdateTransforms();
+            void MarkHierarchyDirty() { hierarchyDirty = true; }
 
             // Skybox management (per-scene override)
             void SetSkyboxCubemap(Rendering::Cubemap* cubemap);
@@ -46,6 +72,17 @@ namespace RTBEngine {
             const std::vector<Rendering::Light*>& GetLights() const { return lights; }
             const std::vector<std::unique_ptr<GameObject>>& GetGameObjects() const { return gameObjects; }
 
+            // All components of type T (or derived from base type T) in this scene, in registration order
+            template<typename T>
+            ComponentView<T> View() const {
+                static_assert(HasComponentTypeId<T>::value, "View<T> requires RTB_COMPONENT or RTB_COMPONENT_TYPE on T");
+                return ComponentView<T>(GetComponentList(T::StaticComponentTypeId()));
+            }
+
+            // Called by GameObject when components are added/removed while it belongs to this scene
+            void RegisterComponent(Component* component);
+            void UnregisterComponent(Component* component);
+
             // Camera management
             void SetMainCamera(CameraComponent* camera);
             CameraComponent* GetMainCamera() const;
@@ -54,9 +91,41 @@ namespace RTBEngine {
             std::string name;
             std::vector<std::unique_ptr<GameObject>> gameObjects;
             std::vector<Rendering::Light*> lights;
+
+            // Sorts a pooled list left unsorted by RegisterComponent before handing it out
+            const std::vector<Component*>& GetComponentList(ComponentTypeId id) const;
+            void SortComponentLists();
+
+            // Per-type component lists, indexed by ComponentTypeId (exact and base ids).
+            // With pooled storage they are sorted by address lazily, once per batch of registrations.
+            mutable std::vector<std::vector<Component*>> componentsByType;
+            mutable std::vector<bool> componentListUnsorted;
+            static const std::vector<Component*> emptyComponentList;
+
+            // Objects per job; smaller batches cost more in scheduling than they save
+            static constexpr size_t PARALLEL_UPDATE_GRAIN = 64;
+
+            void SplitUpdateBatches();
+
+            // Fills the occlusion buffer from every active occluder inside the frustum
+            void RasterizeOccluders(const Math::Matrix4& viewProjection, const Math::Frustum& frustum);
+
+            bool parallelUpdateEnabled = false;
+            std::vector<GameObject*> parallelBatch;
+            std::vector<GameObject*> serialBatch;
+
+            // Transforms in parent-before-child order, rebuilt when the hierarchy changes
+            std::vector<Transform*> transformOrder;
+            bool hierarchyDirty = true;
             
             CameraComponent* mainCamera = nullptr;
 
+            // Reused every frame so submissions do not reallocate
+            Rendering::RenderQueue renderQueue;
+
+            bool occlusionCullingEnabled = false;
+            Rendering::OcclusionCuller occlusionCuller;
+
             // Skybox settings
             Rendering::Cubemap* skyboxCubemap = nullptr;
             bool skyboxEnabled = true;
@@ -1,4 +1,5 @@
 #include "Transform.h"
+#include <algorithm>
 
 namespace RTBEngine {
     namespace ECS {
@@ -19,26 +20,35 @@ namespace RTBEngine {
 
         Transform::~Transform()
         {
+            SetParent(nullptr);
+            for (Transform* child : children) {
+                child->parent = nullptr;
+                child->MarkWorldDirty();
+            }
         }
 
         void Transform::SetPosition(const Math::Vector3& position)
         {
             this->position = position;
+            MarkDirty();
         }
 
         void Transform::SetRotation(const Math::Quaternion& rotation)
         {
             this->rotation = rotation;
+            MarkDirty();
         }
 
         void Transform::SetRotation(const Math::Vector3& eulerAngles)
         {
             this->rotation = Math::Quaternion::FromEulerAngles(eulerAngles);
+            MarkDirty();
         }
 
         void Transform::SetScale(const Math::Vector3& scale)
         {
             this->scale = scale;
+            MarkDirty();
         }
 
         Math::Vector3 Transform::GetForward() const
@@ -64,26 +74,119 @@ namespace RTBEngine {
         void Transform::Translate(const Math::Vector3& translation)
         {
             position += translation;
+            MarkDirty();
         }
 
         void Transform::Rotate(const Math::Quaternion& rotation)
         {
             this->rotation = rotation * this->rotation;
+            MarkDirty();
         }
 
         void Transform::Rotate(const Math::Vector3& eulerAngles)
         {
             Math::Quaternion deltaRotation = Math::Quaternion::FromEulerAngles(eulerAngles);
             this->rotation = deltaRotation * this->rotation;
+            MarkDirty();
         }
 
-        Math::Matrix4 Transform::GetModelMatrix() const
+        const Math::Matrix4& Transform::GetModelMatrix() const
         {
-            Math::Matrix4 translationMatrix = Math::Matrix4::Translate(position);
-            Math::Matrix4 rotationMatrix = rotation.ToMatrix();
-            Math::Matrix4 scaleMatrix = Math::Matrix4::Scale(scale);
+            if (localDirty) {
+                Math::Matrix4 translationMatrix = Math::Matrix4::Translate(position);
+                Math::Matrix4 rotationMatrix = rotation.ToMatrix();
+                Math::Matrix4 scaleMatrix = Math::Matrix4::Scale(scale);
+
+                localMatrix = translationMatrix * rotationMatrix * scaleMatrix;
+                localDirty = false;
+            }
+            return localMatrix;
+        }
+
+        const Math::Matrix4& Transform::GetWorldMatrix() const
+        {
+            if (worldDirty) {
+                UpdateWorld();
+            }
+            return worldMatrix;
+        }
+
+        Math::Vector3 Transform::GetWorldPosition() const
+        {
+            const Math::Matrix4& wm = GetWorldMatrix();
+            return Math::Vector3(wm[12], wm[13], wm[14]);
+        }
+
+        const Math::Quaternion& Transform::GetWorldRotation() const
+        {
+            if (worldDirty) {
+                UpdateWorld();
+            }
+            return worldRotation;
+        }
+
+        const Math::Vector3& Transform::GetWorldScale() const
+        {
+            if (worldDirty) {
+                UpdateWorld();
+            }
+            return worldScale;
+        }
+
+        void Transform::UpdateWorld() const
+        {
+            if (!worldDirty) return;
+
+            if (parent) {
+                // Lazy access still works when called out of order; the parent fills its own cache
+                worldMatrix = parent->GetWorldMatrix() * GetModelMatrix();
+                worldRotation = parent->GetWorldRotation() * rotation;
+                const Math::Vector3& parentScale = parent->GetWorldScale();
+                worldScale = Math::Vector3(parentScale.x * scale.x, parentScale.y * scale.y, parentScale.z * scale.z);
+            }
+            else {
+                worldMatrix = GetModelMatrix();
+                worldRotation = rotation;
+                worldScale = scale;
+            }
+            worldDirty = false;
+        }
+
+        void Transform::SetParent(Transform* newParent)
+        {
+            if (parent == newParent) return;
+
+            if (parent) {
+                auto it = std::find(parent->children.begin(), parent->children.end(), this);
+                if (it != parent->children.end()) {
+                    parent->children.erase(it);
+                }
+            }
+
+            parent = newParent;
+
+            if (parent) {
+                parent->children.push_back(this);
+            }
+
+            MarkWorldDirty();
+        }
+
+        void Transform::MarkDirty()
+        {
+            localDirty = true;
+            MarkWorldDirty();
+        }
+
+        void Transform::MarkWorldDirty()
+        {
+            // A dirty transform always has dirty descendants, so the walk can stop early
+            if (worldDirty) return;
 
-            return translationMatrix * rotationMatrix * scaleMatrix;
+            worldDirty = true;
+            for (Transform* child : children) {
+                child->MarkWorldDirty();
+            }
         }
 
     }
@@ -1,5 +1,6 @@
 #pragma once
 #include "../Math/Math.h"
+#include <vector>
 
 namespace RTBEngine {
     namespace ECS {
@@ -10,6 +11,9 @@ namespace RTBEngine {
             Transform(const Math::Vector3& position, const Math::Quaternion& rotation, const Math::Vector3& scale);
             ~Transform();
 
+            Transform(const Transform&) = delete;
+            Transform& operator=(const Transform&) = delete;
+
             void SetPosition(const Math::Vector3& position);
             void SetRotation(const Math::Quaternion& rotation);
             void SetRotation(const Math::Vector3& eulerAngles);
@@ -27,12 +31,43 @@ namespace RTBEngine {
             void Rotate(const Math::Quaternion& rotation);
             void Rotate(const Math::Vector3& eulerAngles);
 
-            Math::Matrix4 GetModelMatrix() const;
+            // Local TRS matrix, rebuilt only after the transform changed
+            const Math::Matrix4& GetModelMatrix() const;
+
+            // World-space values, cached and invalidated when this transform or any parent changes
+            const Math::Matrix4& GetWorldMatrix() const;
+            Math::Vector3 GetWorldPosition() const;
+            const Math::Quaternion& GetWorldRotation() const;
+            const Math::Vector3& GetWorldScale() const;
+
+            // Hierarchy links, maintained by GameObject::SetParent
+            void SetParent(Transform* newParent);
+            Transform* GetParent() const { return parent; }
+            const std::vector<Transform*>& GetChildren() const { return children; }
+
+            bool IsWorldDirty() const { return worldDirty; }
+
+            // Recomputes the cached world values if needed. The parent must already be up to date
+            // (Scene::UpdateTransforms walks the hierarchy parent-before-child).
+            void UpdateWorld() const;
 
         private:
+            void MarkDirty();
+            void MarkWorldDirty();
+
             Math::Vector3 position;
             Math::Quaternion rotation;
             Math::Vector3 scale;
+
+            Transform* parent = nullptr;
+            std::vector<Transform*> children;
+
+            mutable Math::Matrix4 localMatrix;
+            mutable Math::Matrix4 worldMatrix;
+            mutable Math::Quaternion worldRotation;
+            mutable Math::Vector3 worldScale;
+            mutable bool localDirty = true;
+            mutable bool worldDirty = true;
         };
 
     }
@@ -0,0 +1,55 @@
+#include "AABB.h"
+#include <cfloat>
+#include <algorithm>
+
+namespace RTBEngine {
+    namespace Math {
+
+        AABB::AABB()
+            : min(FLT_MAX, FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX, -FLT_MAX)
+        {
+        }
+
+        AABB::AABB(const Vector3& min, const Vector3& max)
+            : min(min), max(max)
+        {
+        }
+
+        void AABB::Expand(const Vector3& point)
+        {
+            min = Vector3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+            max = Vector3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+        }
+
+        void AABB::Expand(const AABB& other)
+        {
+            if (other.IsEmpty()) return;
+            Expand(other.min);
+            Expand(other.max);
+        }
+
+        AABB AABB::Transformed(const Matrix4& matrix) const
+        {
+            if (IsEmpty()) return AABB();
+
+            // Arvo: each output axis is the translation plus the min/max contribution of every input axis
+            const float* m = matrix.m;
+            float srcMin[3] = { min.x, min.y, min.z };
+            float srcMax[3] = { max.x, max.y, max.z };
+            float outMin[3] = { m[12], m[13], m[14] };
+            float outMax[3] = { m[12], m[13], m[14] };
+
+            for (int row = 0; row < 3; row++) {
+                for (int col = 0; col < 3; col++) {
+                    float a = m[row + col * 4] * srcMin[col];
+                    float b = m[row + col * 4] * srcMax[col];
+                    outMin[row] += std::min(a, b);
+                    outMax[row] += std::max(a, b);
+                }
+            }
+
+            return AABB(Vector3(outMin[0], outMin[1], outMin[2]), Vector3(outMax[0], outMax[1], outMax[2]));
+        }
+
+    }
+}
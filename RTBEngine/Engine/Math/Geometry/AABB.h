@@ -0,0 +1,30 @@
+#pragma once
+#include "../Vectors/Vector3.h"
+#include "../Matrix/Matrix4.h"
+
+namespace RTBEngine {
+    namespace Math {
+
+        // Axis-aligned bounding box. A default-constructed box is empty (min > max).
+        class AABB {
+        public:
+            Vector3 min;
+            Vector3 max;
+
+            AABB();
+            AABB(const Vector3& min, const Vector3& max);
+
+            bool IsEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+            Vector3 GetCenter() const { return (min + max) * 0.5f; }
+            Vector3 GetExtents() const { return (max - min) * 0.5f; }
+
+            void Expand(const Vector3& point);
+            void Expand(const AABB& other);
+
+            // Bounds of the box after an affine transform (exact for the transformed box's corners)
+            AABB Transformed(const Matrix4& matrix) const;
+        };
+
+    }
+}
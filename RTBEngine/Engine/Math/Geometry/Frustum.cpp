@@ -0,0 +1,54 @@
+#include "Frustum.h"
+#include <cmath>
+
+namespace RTBEngine {
+    namespace Math {
+
+        Frustum::Frustum(const Matrix4& viewProjection)
+        {
+            SetFromMatrix(viewProjection);
+        }
+
+        void Frustum::SetFromMatrix(const Matrix4& viewProjection)
+        {
+            // Gribb/Hartmann: planes are sums/differences of the matrix rows (column-major storage)
+            const float* m = viewProjection.m;
+            Vector4 row0(m[0], m[4], m[8], m[12]);
+            Vector4 row1(m[1], m[5], m[9], m[13]);
+            Vector4 row2(m[2], m[6], m[10], m[14]);
+            Vector4 row3(m[3], m[7], m[11], m[15]);
+
+            planes[Left] = row3 + row0;
+            planes[Right] = row3 - row0;
+            planes[Bottom] = row3 + row1;
+            planes[Top] = row3 - row1;
+            planes[Near] = row3 + row2;
+            planes[Far] = row3 - row2;
+
+            for (Vector4& plane : planes) {
+                float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (length > 0.0f) {
+                    plane = plane / length;
+                }
+            }
+        }
+
+        bool Frustum::Intersects(const AABB& box) const
+        {
+            if (box.IsEmpty()) return false;
+
+            for (const Vector4& plane : planes) {
+                // Corner furthest along the plane normal
+                float x = plane.x >= 0.0f ? box.max.x : box.min.x;
+                float y = plane.y >= 0.0f ? box.max.y : box.min.y;
+                float z = plane.z >= 0.0f ? box.max.z : box.min.z;
+
+                if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    }
+}
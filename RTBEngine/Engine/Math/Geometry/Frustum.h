@@ -0,0 +1,30 @@
+#pragma once
+#include "AABB.h"
+#include "../Vectors/Vector4.h"
+#include "../Matrix/Matrix4.h"
+
+namespace RTBEngine {
+    namespace Math {
+
+        // Six clip planes extracted from a view-projection matrix (GL clip space, -w..w).
+        // Plane normals point inwards: a point p is inside when dot(n, p) + d >= 0.
+        class Frustum {
+        public:
+            enum Plane { Left = 0, Right, Bottom, Top, Near, Far, PlaneCount };
+
+            Frustum() = default;
+            explicit Frustum(const Matrix4& viewProjection);
+
+            void SetFromMatrix(const Matrix4& viewProjection);
+
+            // Conservative: may report boxes near frustum corners as visible
+            bool Intersects(const AABB& box) const;
+
+            const Vector4& GetPlane(int index) const { return planes[index]; }
+
+        private:
+            Vector4 planes[PlaneCount];
+        };
+
+    }
+}
@@ -4,4 +4,6 @@
 #include "Vectors/Vector3.h"
 #include "Vectors/Vector4.h"
 #include "Matrix/Matrix4.h"
-#include "Quaternions/Quaternion.h"
\ No newline at end of file
+#include "Quaternions/Quaternion.h"
+#include "Geometry/AABB.h"
+#include "Geometry/Frustum.h"
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../ECS/RigidBodyComponent.h"
 #include "../ECS/BoxColliderComponent.h"
 #include "CollisionInfo.h"
+#include "../Core/Profiler.h"
 #include <BulletCollision/NarrowPhaseCollision/btPersistentManifold.h>
 
 namespace RTBEngine {
@@ -25,10 +26,24 @@ namespace RTBEngine {
             if (!scene || !physicsWorld)
                 return;
 
-            SyncTransformsToPhysics(scene);
-            physicsWorld->Step(deltaTime);
-            ProcessCollisions();
-            SyncPhysicsToTransforms(scene);
+            RTB_PROFILE_SCOPE("PhysicsSystem::Update");
+
+            {
+                RTB_PROFILE_SCOPE("PhysicsSystem::SyncTransformsToPhysics");
+                SyncTransformsToPhysics(scene);
+            }
+            {
+                RTB_PROFILE_SCOPE("PhysicsWorld::Step");
+                physicsWorld->Step(deltaTime);
+            }
+            {
+                RTB_PROFILE_SCOPE("PhysicsSystem::ProcessCollisions");
+                ProcessCollisions();
+            }
+            {
+                RTB_PROFILE_SCOPE("PhysicsSystem::SyncPhysicsToTransforms");
+                SyncPhysicsToTransforms(scene);
+            }
         }
 
         void PhysicsSystem::InitializeCollider(ECS::GameObject* gameObject, ECS::BoxColliderComponent* boxCollider)
@@ -136,15 +151,13 @@ namespace RTBEngine {
 
         void PhysicsSystem::SyncTransformsToPhysics(ECS::Scene* scene)
         {
-            const auto& gameObjects = scene->GetGameObjects();
-
-            for (const auto& gameObject : gameObjects)
+            for (ECS::RigidBodyComponent* rbComp : scene->View<ECS::RigidBodyComponent>())
             {
+                ECS::GameObject* gameObject = rbComp->GetOwner();
                 if (!gameObject->IsActive())
                     continue;
 
-                ECS::RigidBodyComponent* rbComp = gameObject->GetComponent<ECS::RigidBodyComponent>();
-                if (!rbComp || !rbComp->HasRigidBody())
+                if (!rbComp->HasRigidBody())
                     continue;
 
                 Physics::RigidBody* rigidBody = rbComp->GetRigidBody();
@@ -170,15 +183,13 @@ namespace RTBEngine {
 
         void PhysicsSystem::SyncPhysicsToTransforms(ECS::Scene* scene)
         {
-            const auto& gameObjects = scene->GetGameObjects();
-
-            for (const auto& gameObject : gameObjects)
+            for (ECS::RigidBodyComponent* rbComp : scene->View<ECS::RigidBodyComponent>())
             {
+                ECS::GameObject* gameObject = rbComp->GetOwner();
                 if (!gameObject->IsActive())
                     continue;
 
-                ECS::RigidBodyComponent* rbComp = gameObject->GetComponent<ECS::RigidBodyComponent>();
-                if (!rbComp || !rbComp->HasRigidBody())
+                if (!rbComp->HasRigidBody())
                     continue;
 
                 Physics::RigidBody* rigidBody = rbComp->GetRigidBody();
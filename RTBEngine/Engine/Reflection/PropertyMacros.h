@@ -1,5 +1,6 @@
 #pragma once
 #include "TypeInfo.h"
+#include "../ECS/ComponentTypeId.h"
 #include "../Math/Math.h"
 
 // Usage in header:
@@ -18,13 +19,15 @@
 //   RTB_REGISTER_COMPONENT(MyComponent)
 //       RTB_PROPERTY(speed)
 //       RTB_PROPERTY_SERIALIZED(maxHealth)
+//       RTB_ACCESS(OwnerOnly)         // Optional: allows parallel update
 //   RTB_END_REGISTER()
 
 // Marks a private variable as visible in Inspector (semantic marker only)
 #define RTB_SERIALIZE()
 
-// Required at end of component class - generates GetTypeName() and GetTypeInfo()
+// Required at end of component class - generates GetTypeName(), GetTypeInfo() and the type id
 #define RTB_COMPONENT(ClassName)                                                        \
+    RTB_COMPONENT_TYPE(ClassName)                                                       \
 public:                                                                                 \
     virtual const char* GetTypeName() const override { return #ClassName; }             \
     virtual const RTBEngine::Reflection::TypeInfo* GetTypeInfo() const override {       \
@@ -203,6 +206,10 @@ private:
                     info.AddProperty(prop);                                             \
                 }
 
+// Declares what the component's update touches (see ComponentAccess), e.g. RTB_ACCESS(OwnerOnly)
+#define RTB_ACCESS(Access)                                                              \
+                info.SetAccess(RTBEngine::Reflection::ComponentAccess::Access);
+
 // Ends property registration - pass ClassName again
 #define RTB_END_REGISTER(ClassName)                                                     \
                 RTBEngine::Reflection::TypeRegistry::GetInstance().RegisterType(        \
@@ -57,6 +57,19 @@ namespace RTBEngine {
             return (static_cast<uint32_t>(flags) & static_cast<uint32_t>(flag)) != 0;
         }
 
+        // What a component's OnUpdate/OnFixedUpdate touches. Scene::Update runs objects whose components
+        // are all OwnerOnly on worker threads; anything else stays on the main thread.
+        enum class ComponentAccess : uint32_t {
+            OwnerOnly           = 0,        // Only its own GameObject's transform and components
+            ReadsOtherObjects   = 1 << 0,   // Reads transforms/components of other GameObjects
+            WritesOtherObjects  = 1 << 1,   // Writes other GameObjects
+            MainThread          = 1 << 2,   // Input, audio, GL/ImGui, Lua or scene mutation
+        };
+
+        inline ComponentAccess operator|(ComponentAccess a, ComponentAccess b) {
+            return static_cast<ComponentAccess>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+        }
+
         // Range metadata for numeric sliders
         struct Range {
             float min;
@@ -119,10 +132,16 @@ namespace RTBEngine {
 
             ECS::Component* Create() const { return factory ? factory() : nullptr; }
 
+            // Defaults to MainThread so undeclared components are never run concurrently
+            void SetAccess(ComponentAccess newAccess) { access = newAccess; }
+            ComponentAccess GetAccess() const { return access; }
+            bool IsParallelUpdateSafe() const { return access == ComponentAccess::OwnerOnly; }
+
         private:
             std::string typeName;
             std::vector<PropertyInfo> properties;
             FactoryFunc factory;
+            ComponentAccess access = ComponentAccess::MainThread;
         };
 
         // Global registry for all reflected types
@@ -0,0 +1,73 @@
+#include "BonePaletteBuffer.h"
+#include "GraphicsContext.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        BonePaletteBuffer::BonePaletteBuffer()
+            : bufferID(0), capacity(0)
+        {
+        }
+
+        BonePaletteBuffer::~BonePaletteBuffer()
+        {
+            Shutdown();
+        }
+
+        bool BonePaletteBuffer::Initialize()
+        {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
+            Shutdown();
+
+            capacity = INITIAL_CAPACITY;
+            glGenBuffers(1, &bufferID);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferID);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(Math::Matrix4), nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_POINT, bufferID);
+            return true;
+        }
+
+        void BonePaletteBuffer::Shutdown()
+        {
+            if (bufferID != 0) {
+                glDeleteBuffers(1, &bufferID);
+                bufferID = 0;
+            }
+            capacity = 0;
+            staging.clear();
+        }
+
+        void BonePaletteBuffer::BeginFrame()
+        {
+            staging.clear();
+        }
+
+        int32_t BonePaletteBuffer::Append(const std::vector<Math::Matrix4>& boneTransforms)
+        {
+            int32_t offset = static_cast<int32_t>(staging.size());
+            staging.insert(staging.end(), boneTransforms.begin(), boneTransforms.end());
+            return offset;
+        }
+
+        void BonePaletteBuffer::Upload()
+        {
+            if (bufferID == 0 || staging.empty()) return;
+
+            while (capacity < staging.size()) {
+                capacity *= 2;
+            }
+
+            // Orphan the previous frame's storage so the upload never waits on draws still reading it
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferID);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, capacity * sizeof(Math::Matrix4), nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, staging.size() * sizeof(Math::Matrix4), staging.data());
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        }
+
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <GL/glew.h>
+#include "../Math/Math.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Shader storage buffer holding every animator's bone palette for the current frame.
+        // Palettes are appended on the CPU, uploaded with a single call, and draws select theirs
+        // through the uBoneOffset uniform (index of the palette's first matrix).
+        class BonePaletteBuffer {
+        public:
+            // layout(std430, binding = N) in basic.vert / shadow.vert
+            static constexpr GLuint BINDING_POINT = 3;
+            static constexpr size_t INITIAL_CAPACITY = 1024;
+
+            BonePaletteBuffer();
+            ~BonePaletteBuffer();
+
+            BonePaletteBuffer(const BonePaletteBuffer&) = delete;
+            BonePaletteBuffer& operator=(const BonePaletteBuffer&) = delete;
+
+            bool Initialize();
+            void Shutdown();
+
+            void BeginFrame();
+
+            // Stages a palette and returns its offset in matrices
+            int32_t Append(const std::vector<Math::Matrix4>& boneTransforms);
+
+            // Uploads everything staged since BeginFrame
+            void Upload();
+
+            size_t GetMatrixCount() const { return staging.size(); }
+
+        private:
+            GLuint bufferID;
+            size_t capacity;
+            std::vector<Math::Matrix4> staging;
+        };
+
+    }
+}
@@ -2,6 +2,7 @@
 #include <stb_image.h>
 #include <iostream>
 #include "../RTBEngine.h"
+#include "GLStateCache.h"
 #include <array>
 
 namespace RTBEngine {
@@ -13,6 +14,7 @@ namespace RTBEngine {
         Cubemap::~Cubemap() {
             if (textureID != 0) {
                 glDeleteTextures(1, &textureID);
+                GLStateCache::GetInstance().OnTextureDeleted(textureID);
             }
         }
 
@@ -31,7 +33,7 @@ namespace RTBEngine {
 
         bool Cubemap::LoadFromFiles(const std::array<std::string, 6>& facePaths) {
             glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
             GLenum targets[6] = {
                 GL_TEXTURE_CUBE_MAP_POSITIVE_X,  // right
@@ -51,6 +53,7 @@ namespace RTBEngine {
                 if (!data) {
                     RTB_ERROR("Failed to load cubemap face: " + facePaths[i]);
                     glDeleteTextures(1, &textureID);
+                    GLStateCache::GetInstance().OnTextureDeleted(textureID);
                     textureID = 0;
                     return false;
                 }
@@ -71,14 +74,12 @@ namespace RTBEngine {
             glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-
-            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
             return true;
         }
 
         bool Cubemap::CreateSolidColor(float r, float g, float b) {
             glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
             unsigned char color[3] = {
                 static_cast<unsigned char>(r * 255),
@@ -95,18 +96,15 @@ namespace RTBEngine {
             glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-
-            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
             return true;
         }
 
         void Cubemap::Bind(unsigned int slot) const {
-            glActiveTexture(GL_TEXTURE0 + slot);
-            glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+            GLStateCache::GetInstance().BindTexture(slot, GL_TEXTURE_CUBE_MAP, textureID);
         }
 
-        void Cubemap::Unbind() const {
-            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        void Cubemap::Unbind(unsigned int slot) const {
+            GLStateCache::GetInstance().BindTexture(slot, GL_TEXTURE_CUBE_MAP, 0);
         }
 
     }
@@ -25,7 +25,7 @@ namespace RTBEngine {
             bool CreateSolidColor(float r, float g, float b);
 
             void Bind(unsigned int slot = 0) const;
-            void Unbind() const;
+            void Unbind(unsigned int slot = 0) const;
 
             GLuint GetID() const { return textureID; }
             bool IsLoaded() const { return textureID != 0; }
@@ -1,6 +1,7 @@
 #include "Framebuffer.h"
 #include <iostream>
 #include "../RTBEngine.h"
+#include "GLStateCache.h"
 
 namespace RTBEngine {
     namespace Rendering {
@@ -11,6 +12,7 @@ namespace RTBEngine {
             DeleteTextures();
             if (fboID != 0) {
                 glDeleteFramebuffers(1, &fboID);
+                GLStateCache::GetInstance().OnFramebufferDeleted(fboID);
             }
         }
 
@@ -57,7 +59,7 @@ namespace RTBEngine {
         void Framebuffer::CreateTextures() {
             // Create color texture
             glGenTextures(1, &colorTextureID);
-            glBindTexture(GL_TEXTURE_2D, colorTextureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, colorTextureID);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -67,32 +69,32 @@ namespace RTBEngine {
 
             // Create depth texture
             glGenTextures(1, &depthTextureID);
-            glBindTexture(GL_TEXTURE_2D, depthTextureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, depthTextureID);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTextureID, 0);
-
-            glBindTexture(GL_TEXTURE_2D, 0);
         }
 
         void Framebuffer::DeleteTextures() {
             if (colorTextureID != 0) {
                 glDeleteTextures(1, &colorTextureID);
+                GLStateCache::GetInstance().OnTextureDeleted(colorTextureID);
                 colorTextureID = 0;
             }
             if (depthTextureID != 0) {
                 glDeleteTextures(1, &depthTextureID);
+                GLStateCache::GetInstance().OnTextureDeleted(depthTextureID);
                 depthTextureID = 0;
             }
         }
 
         void Framebuffer::Bind() const {
-            glBindFramebuffer(GL_FRAMEBUFFER, fboID);
+            GLStateCache::GetInstance().BindFramebuffer(fboID);
         }
 
         void Framebuffer::Unbind() const {
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            GLStateCache::GetInstance().BindFramebuffer(0);
         }
 
         void Framebuffer::AttachDepthTexture(GLuint textureID) {
@@ -101,6 +103,12 @@ namespace RTBEngine {
             glReadBuffer(GL_NONE);
         }
 
+        void Framebuffer::AttachDepthTextureLayer(GLuint textureID, int layer) {
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, textureID, 0, layer);
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+
         void Framebuffer::AttachColorTexture(GLuint textureID) {
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureID, 0);
         }
@@ -18,6 +18,7 @@ namespace RTBEngine {
             void Bind() const;
             void Unbind() const;
             void AttachDepthTexture(GLuint textureID);
+            void AttachDepthTextureLayer(GLuint textureID, int layer);
             void AttachColorTexture(GLuint textureID);
             bool IsComplete() const;
 
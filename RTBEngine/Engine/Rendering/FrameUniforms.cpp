@@ -0,0 +1,85 @@
+#include "FrameUniforms.h"
+#include "Camera.h"
+#include "Lighting/Light.h"
+#include "Lighting/DirectionalLight.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static_assert(sizeof(CameraUniforms) == 3 * 64 + 16, "CameraUniforms must match the std140 CameraBlock");
+        static_assert(sizeof(LightUniforms) == 32, "LightUniforms must match the std140 LightBlock");
+        static_assert(MAX_SHADOW_CASCADES <= 4, "Cascade splits are packed into one vec4");
+        static_assert(sizeof(ShadowUniforms) == MAX_SHADOW_CASCADES * 64 + 32, "ShadowUniforms must match the std140 ShadowBlock");
+
+        static void StoreVec4(float* out, const Math::Vector3& v, float w)
+        {
+            out[0] = v.x;
+            out[1] = v.y;
+            out[2] = v.z;
+            out[3] = w;
+        }
+
+        bool FrameUniforms::Initialize()
+        {
+            return cameraBuffer.Initialize(CAMERA_UNIFORM_BINDING, sizeof(CameraUniforms))
+                && lightBuffer.Initialize(LIGHT_UNIFORM_BINDING, sizeof(LightUniforms))
+                && shadowBuffer.Initialize(SHADOW_UNIFORM_BINDING, sizeof(ShadowUniforms));
+        }
+
+        void FrameUniforms::Shutdown()
+        {
+            cameraBuffer.Shutdown();
+            lightBuffer.Shutdown();
+            shadowBuffer.Shutdown();
+        }
+
+        void FrameUniforms::UpdateCamera(Camera* camera)
+        {
+            if (!camera) return;
+
+            CameraUniforms data;
+            data.view = camera->GetViewMatrix();
+            data.projection = camera->GetProjectionMatrix();
+            data.viewProjection = data.projection * data.view;
+            StoreVec4(data.viewPosition, camera->GetPosition(), 1.0f);
+
+            cameraBuffer.Update(&data, sizeof(data));
+        }
+
+        void FrameUniforms::UpdateLights(const std::vector<Light*>& lights)
+        {
+            std::memset(&lightData, 0, sizeof(lightData));
+
+            for (Light* light : lights) {
+                if (!light || light->GetType() != LightType::Directional) continue;
+
+                // Only one directional light is shaded; the last one wins
+                auto* dirLight = static_cast<DirectionalLight*>(light);
+                StoreVec4(lightData.directional.direction, dirLight->GetDirection(), 0.0f);
+                StoreVec4(lightData.directional.colorIntensity, dirLight->GetColor(), dirLight->GetIntensity());
+            }
+
+            lightBuffer.Update(&lightData, sizeof(lightData));
+        }
+
+        void FrameUniforms::UpdateShadow(const ShadowCascade* cascades, int cascadeCount, float bias)
+        {
+            ShadowUniforms data;
+
+            cascadeCount = cascades ? std::min(cascadeCount, MAX_SHADOW_CASCADES) : 0;
+            for (int i = 0; i < MAX_SHADOW_CASCADES; ++i) {
+                bool used = i < cascadeCount;
+                data.lightSpaceMatrices[i] = used ? cascades[i].lightSpaceMatrix : Math::Matrix4::Identity();
+                data.cascadeSplits[i] = used ? cascades[i].splitFar : 0.0f;
+            }
+            data.params[0] = cascadeCount > 0 ? 1.0f : 0.0f;
+            data.params[1] = bias;
+            data.params[2] = static_cast<float>(cascadeCount);
+
+            shadowBuffer.Update(&data, sizeof(data));
+        }
+
+    }
+}
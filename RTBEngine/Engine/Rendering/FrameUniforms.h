@@ -0,0 +1,67 @@
+#pragma once
+#include "UniformBuffer.h"
+#include "ShadowMap.h"
+#include "../Math/Math.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        class Camera;
+        class Light;
+        struct ShadowCascade;
+
+        // Binding points shared with the shaders (layout(std140, binding = N))
+        constexpr GLuint CAMERA_UNIFORM_BINDING = 0;
+        constexpr GLuint LIGHT_UNIFORM_BINDING = 1;
+        constexpr GLuint SHADOW_UNIFORM_BINDING = 2;
+
+        // The structs below mirror the std140 blocks in Default/Shaders; every member is a vec4 or
+        // mat4 so C++ and GLSL agree on offsets without padding rules. Keep both sides in sync.
+
+        struct CameraUniforms {
+            Math::Matrix4 view;
+            Math::Matrix4 projection;
+            Math::Matrix4 viewProjection;
+            float viewPosition[4];          // xyz
+        };
+
+        struct DirectionalLightUniforms {
+            float direction[4];             // xyz
+            float colorIntensity[4];        // rgb, intensity
+        };
+
+        // Point and spot lights are not in here; they go through LightClusters
+        struct LightUniforms {
+            DirectionalLightUniforms directional;
+        };
+
+        struct ShadowUniforms {
+            Math::Matrix4 lightSpaceMatrices[MAX_SHADOW_CASCADES];
+            float cascadeSplits[4];         // view-space far distance of each cascade
+            float params[4];                // has shadows (0/1), bias, cascade count
+        };
+
+        // Owns the per-frame uniform buffers. Each block is uploaded once per frame (the shadow block
+        // once per shadow-casting light) instead of per shader and per draw.
+        class FrameUniforms {
+        public:
+            bool Initialize();
+            void Shutdown();
+
+            void UpdateCamera(Camera* camera);
+            void UpdateLights(const std::vector<Light*>& lights);
+            // cascadeCount 0 disables shadow sampling
+            void UpdateShadow(const ShadowCascade* cascades, int cascadeCount, float bias);
+
+        private:
+            UniformBuffer cameraBuffer;
+            UniformBuffer lightBuffer;
+            UniformBuffer shadowBuffer;
+
+            LightUniforms lightData;
+        };
+
+    }
+}
@@ -0,0 +1,198 @@
+#include "GLStateCache.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        uint32_t GLStateStats::GetTotalIssued() const
+        {
+            uint32_t total = 0;
+            for (uint32_t count : issued) total += count;
+            return total;
+        }
+
+        uint32_t GLStateStats::GetTotalSkipped() const
+        {
+            uint32_t total = 0;
+            for (uint32_t count : skipped) total += count;
+            return total;
+        }
+
+        GLStateCache& GLStateCache::GetInstance()
+        {
+            static GLStateCache instance;
+            return instance;
+        }
+
+        GLStateCache::GLStateCache()
+        {
+            Invalidate();
+        }
+
+        void GLStateCache::Invalidate()
+        {
+            program = UNKNOWN;
+            vertexArray = UNKNOWN;
+            activeUnit = UNKNOWN;
+            for (auto& unit : textures) {
+                for (GLuint& texture : unit) {
+                    texture = UNKNOWN;
+                }
+            }
+            framebuffer = UNKNOWN;
+            depthFunc = UNKNOWN;
+            cullMode = UNKNOWN;
+            depthTest = -1;
+            cullFace = -1;
+            viewportKnown = false;
+        }
+
+        void GLStateCache::BeginFrame()
+        {
+            frameStats = currentStats;
+            currentStats.Reset();
+        }
+
+        bool GLStateCache::Track(GLStateCall call, bool changed)
+        {
+            size_t index = static_cast<size_t>(call);
+            if (changed) {
+                currentStats.issued[index]++;
+            }
+            else {
+                currentStats.skipped[index]++;
+            }
+            return changed;
+        }
+
+        int GLStateCache::GetTargetIndex(GLenum target)
+        {
+            switch (target) {
+            case GL_TEXTURE_2D: return Texture2D;
+            case GL_TEXTURE_CUBE_MAP: return TextureCubeMap;
+            case GL_TEXTURE_2D_ARRAY: return Texture2DArray;
+            default: return -1;
+            }
+        }
+
+        void GLStateCache::UseProgram(GLuint newProgram)
+        {
+            if (Track(GLStateCall::UseProgram, program != newProgram)) {
+                glUseProgram(newProgram);
+                program = newProgram;
+            }
+        }
+
+        void GLStateCache::BindVertexArray(GLuint vao)
+        {
+            if (Track(GLStateCall::BindVertexArray, vertexArray != vao)) {
+                glBindVertexArray(vao);
+                vertexArray = vao;
+            }
+        }
+
+        void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint texture)
+        {
+            int targetIndex = GetTargetIndex(target);
+            bool cached = targetIndex >= 0 && unit < MAX_TEXTURE_UNITS;
+
+            if (cached && !Track(GLStateCall::BindTexture, textures[unit][targetIndex] != texture)) {
+                return;
+            }
+
+            if (Track(GLStateCall::ActiveTexture, activeUnit != unit)) {
+                glActiveTexture(GL_TEXTURE0 + unit);
+                activeUnit = unit;
+            }
+
+            if (!cached) {
+                Track(GLStateCall::BindTexture, true);
+            }
+            glBindTexture(target, texture);
+            if (cached) {
+                textures[unit][targetIndex] = texture;
+            }
+        }
+
+        void GLStateCache::BindFramebuffer(GLuint newFramebuffer)
+        {
+            if (Track(GLStateCall::BindFramebuffer, framebuffer != newFramebuffer)) {
+                glBindFramebuffer(GL_FRAMEBUFFER, newFramebuffer);
+                framebuffer = newFramebuffer;
+            }
+        }
+
+        void GLStateCache::SetDepthTest(bool enabled)
+        {
+            if (Track(GLStateCall::DepthTest, depthTest != static_cast<int>(enabled))) {
+                if (enabled) glEnable(GL_DEPTH_TEST);
+                else glDisable(GL_DEPTH_TEST);
+                depthTest = enabled ? 1 : 0;
+            }
+        }
+
+        void GLStateCache::SetDepthFunc(GLenum func)
+        {
+            if (Track(GLStateCall::DepthFunc, depthFunc != func)) {
+                glDepthFunc(func);
+                depthFunc = func;
+            }
+        }
+
+        void GLStateCache::SetCullFace(bool enabled)
+        {
+            if (Track(GLStateCall::CullFace, cullFace != static_cast<int>(enabled))) {
+                if (enabled) glEnable(GL_CULL_FACE);
+                else glDisable(GL_CULL_FACE);
+                cullFace = enabled ? 1 : 0;
+            }
+        }
+
+        void GLStateCache::SetCullMode(GLenum mode)
+        {
+            if (Track(GLStateCall::CullMode, cullMode != mode)) {
+                glCullFace(mode);
+                cullMode = mode;
+            }
+        }
+
+        void GLStateCache::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+        {
+            bool changed = !viewportKnown
+                || viewport[0] != x || viewport[1] != y || viewport[2] != width || viewport[3] != height;
+            if (Track(GLStateCall::Viewport, changed)) {
+                glViewport(x, y, width, height);
+                viewport[0] = x;
+                viewport[1] = y;
+                viewport[2] = width;
+                viewport[3] = height;
+                viewportKnown = true;
+            }
+        }
+
+        void GLStateCache::OnVertexArrayDeleted(GLuint vao)
+        {
+            if (vertexArray == vao) {
+                vertexArray = 0;
+            }
+        }
+
+        void GLStateCache::OnTextureDeleted(GLuint texture)
+        {
+            for (auto& unit : textures) {
+                for (GLuint& bound : unit) {
+                    if (bound == texture) {
+                        bound = 0;
+                    }
+                }
+            }
+        }
+
+        void GLStateCache::OnFramebufferDeleted(GLuint deleted)
+        {
+            if (framebuffer == deleted) {
+                framebuffer = 0;
+            }
+        }
+
+    }
+}
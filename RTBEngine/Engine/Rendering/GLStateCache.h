@@ -0,0 +1,103 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        enum class GLStateCall {
+            UseProgram,
+            BindVertexArray,
+            ActiveTexture,
+            BindTexture,
+            BindFramebuffer,
+            DepthTest,
+            DepthFunc,
+            CullFace,
+            CullMode,
+            Viewport,
+            Count
+        };
+
+        // Calls that reached the driver vs. calls dropped because the state already matched
+        struct GLStateStats {
+            uint32_t issued[static_cast<size_t>(GLStateCall::Count)] = {};
+            uint32_t skipped[static_cast<size_t>(GLStateCall::Count)] = {};
+
+            uint32_t GetIssued(GLStateCall call) const { return issued[static_cast<size_t>(call)]; }
+            uint32_t GetSkipped(GLStateCall call) const { return skipped[static_cast<size_t>(call)]; }
+            uint32_t GetTotalIssued() const;
+            uint32_t GetTotalSkipped() const;
+
+            void Reset() { *this = GLStateStats(); }
+        };
+
+        // Mirror of the GL binding and fixed-function state the engine changes. Engine code goes
+        // through here instead of calling GL directly, so a call that would not change anything
+        // never reaches the driver. Code that bypasses the cache (ImGui's backend) must call
+        // Invalidate afterwards.
+        class GLStateCache {
+        public:
+            static constexpr GLuint MAX_TEXTURE_UNITS = 16;
+
+            static GLStateCache& GetInstance();
+
+            GLStateCache(const GLStateCache&) = delete;
+            GLStateCache& operator=(const GLStateCache&) = delete;
+
+            void UseProgram(GLuint program);
+            void BindVertexArray(GLuint vao);
+            void BindTexture(GLuint unit, GLenum target, GLuint texture);
+            void BindFramebuffer(GLuint framebuffer);
+            void SetDepthTest(bool enabled);
+            void SetDepthFunc(GLenum func);
+            void SetCullFace(bool enabled);
+            void SetCullMode(GLenum mode);
+            void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+            // GL reverts a deleted object's bindings to 0; call these right after the glDelete*
+            void OnVertexArrayDeleted(GLuint vao);
+            void OnTextureDeleted(GLuint texture);
+            void OnFramebufferDeleted(GLuint framebuffer);
+
+            // Forgets all tracked state so the next call of every kind is issued
+            void Invalidate();
+
+            // Publishes the counters of the frame that just ended and starts counting again
+            void BeginFrame();
+
+            const GLStateStats& GetFrameStats() const { return frameStats; }
+            const GLStateStats& GetCurrentStats() const { return currentStats; }
+
+        private:
+            GLStateCache();
+            ~GLStateCache() = default;
+
+            // Tracked texture targets per unit; others bypass the cache
+            enum TextureTarget { Texture2D, TextureCubeMap, Texture2DArray, TextureTargetCount };
+
+            static int GetTargetIndex(GLenum target);
+
+            // Returns true when the call has to be issued, and counts it either way
+            bool Track(GLStateCall call, bool changed);
+
+            static constexpr GLuint UNKNOWN = 0xFFFFFFFFu;
+
+            GLuint program;
+            GLuint vertexArray;
+            GLuint activeUnit;
+            GLuint textures[MAX_TEXTURE_UNITS][TextureTargetCount];
+            GLuint framebuffer;
+            GLuint depthFunc;
+            GLuint cullMode;
+            int depthTest;
+            int cullFace;
+            GLint viewport[4];
+            bool viewportKnown;
+
+            GLStateStats currentStats;
+            GLStateStats frameStats;
+        };
+
+    }
+}
@@ -0,0 +1,145 @@
+#include "GPUTimer.h"
+#include "GraphicsContext.h"
+#include "../Core/Profiler.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        GPUTimer::GPUTimer()
+        {
+        }
+
+        GPUTimer::~GPUTimer()
+        {
+            Shutdown();
+        }
+
+        void GPUTimer::Shutdown()
+        {
+            if (!isInitialized) return;
+
+            for (FrameQueries& frame : frames) {
+                for (PassQueries& pass : frame.passes) {
+                    glDeleteQueries(1, &pass.startQuery);
+                    glDeleteQueries(1, &pass.endQuery);
+                }
+                frame.passes.clear();
+                frame.usedPasses = 0;
+                frame.pending = false;
+            }
+            results.clear();
+            openPass = -1;
+            isInitialized = false;
+        }
+
+        bool GPUTimer::Initialize()
+        {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
+            Calibrate();
+            isInitialized = true;
+            return true;
+        }
+
+        void GPUTimer::Calibrate()
+        {
+            GLint64 gpuNow = 0;
+            glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+            gpuToCpuOffsetNs = static_cast<int64_t>(Core::Profiler::GetInstance().Now()) - static_cast<int64_t>(gpuNow);
+        }
+
+        void GPUTimer::BeginFrame()
+        {
+            if (!isInitialized) return;
+
+            // This slot was last used FRAME_LATENCY frames ago
+            FrameQueries& frame = frames[currentFrame];
+            if (frame.pending) {
+                CollectFrame(frame);
+            }
+            frame.usedPasses = 0;
+            frame.pending = false;
+        }
+
+        void GPUTimer::BeginPass(const char* name)
+        {
+            if (!isInitialized || openPass >= 0) return;
+
+            FrameQueries& frame = frames[currentFrame];
+            if (frame.usedPasses == frame.passes.size()) {
+                PassQueries pass;
+                glGenQueries(1, &pass.startQuery);
+                glGenQueries(1, &pass.endQuery);
+                frame.passes.push_back(pass);
+            }
+
+            PassQueries& pass = frame.passes[frame.usedPasses];
+            pass.name = name;
+            glQueryCounter(pass.startQuery, GL_TIMESTAMP);
+            openPass = static_cast<int>(frame.usedPasses++);
+        }
+
+        void GPUTimer::EndPass()
+        {
+            if (!isInitialized || openPass < 0) return;
+
+            glQueryCounter(frames[currentFrame].passes[openPass].endQuery, GL_TIMESTAMP);
+            openPass = -1;
+        }
+
+        void GPUTimer::EndFrame()
+        {
+            if (!isInitialized) return;
+
+            EndPass();
+            frames[currentFrame].pending = frames[currentFrame].usedPasses > 0;
+            currentFrame = (currentFrame + 1) % FRAME_LATENCY;
+        }
+
+        void GPUTimer::CollectFrame(FrameQueries& frame)
+        {
+            // Timestamps resolve in order; if the last one is not ready the frame is dropped
+            // rather than waited for
+            GLuint lastQuery = frame.passes[frame.usedPasses - 1].endQuery;
+            GLint available = 0;
+            glGetQueryObjectiv(lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                return;
+            }
+
+            results.clear();
+            for (size_t i = 0; i < frame.usedPasses; ++i) {
+                const PassQueries& pass = frame.passes[i];
+                GLuint64 start = 0;
+                GLuint64 end = 0;
+                glGetQueryObjectui64v(pass.startQuery, GL_QUERY_RESULT, &start);
+                glGetQueryObjectui64v(pass.endQuery, GL_QUERY_RESULT, &end);
+
+                GPUPassTiming timing;
+                timing.name = pass.name;
+                timing.milliseconds = end > start ? (end - start) / 1000000.0 : 0.0;
+                results.push_back(timing);
+
+#if RTB_ENABLE_PROFILER
+                Core::Profiler::GetInstance().RecordExternal(pass.name,
+                    static_cast<uint64_t>(static_cast<int64_t>(start) + gpuToCpuOffsetNs),
+                    static_cast<uint64_t>(static_cast<int64_t>(end) + gpuToCpuOffsetNs),
+                    Core::Profiler::EXTERNAL_TRACK_BASE);
+#endif
+            }
+        }
+
+        double GPUTimer::GetPassTimeMs(const std::string& name) const
+        {
+            for (const GPUPassTiming& timing : results) {
+                if (name == timing.name) {
+                    return timing.milliseconds;
+                }
+            }
+            return 0.0;
+        }
+
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <GL/glew.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        struct GPUPassTiming {
+            const char* name = nullptr;
+            double milliseconds = 0.0;
+        };
+
+        // Per-pass GPU timings from GL_TIMESTAMP queries. Queries are triple-buffered: a frame's
+        // results are read FRAME_LATENCY frames later, and only if already available, so reading
+        // never stalls the pipeline. Pass names must have static storage (string literals).
+        class GPUTimer {
+        public:
+            static constexpr int FRAME_LATENCY = 3;
+
+            GPUTimer();
+            ~GPUTimer();
+
+            GPUTimer(const GPUTimer&) = delete;
+            GPUTimer& operator=(const GPUTimer&) = delete;
+
+            bool Initialize();
+            // Releases the queries; must run while the GL context is still alive
+            void Shutdown();
+
+            void BeginFrame();
+            void BeginPass(const char* name);
+            void EndPass();
+            void EndFrame();
+
+            // Passes of the most recent frame whose results have arrived
+            const std::vector<GPUPassTiming>& GetResults() const { return results; }
+            double GetPassTimeMs(const std::string& name) const;
+
+        private:
+            struct PassQueries {
+                const char* name = nullptr;
+                GLuint startQuery = 0;
+                GLuint endQuery = 0;
+            };
+
+            struct FrameQueries {
+                std::vector<PassQueries> passes;
+                size_t usedPasses = 0;
+                bool pending = false;
+            };
+
+            void CollectFrame(FrameQueries& frame);
+            void Calibrate();
+
+            std::array<FrameQueries, FRAME_LATENCY> frames;
+            int currentFrame = 0;
+            int openPass = -1;
+            bool isInitialized = false;
+
+            // GPU timestamp -> profiler clock, so passes line up with CPU scopes in the trace
+            int64_t gpuToCpuOffsetNs = 0;
+
+            std::vector<GPUPassTiming> results;
+        };
+
+    }
+}
@@ -0,0 +1,330 @@
+#include "GeometryArena.h"
+#include "GLStateCache.h"
+#include "InstanceBuffer.h"
+#include "../Core/Logger.h"
+#include <iterator>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static constexpr size_t INDEX_ALIGNMENT = 4;
+
+        void GeometryArena::RangeAllocator::Reset(size_t newCapacity)
+        {
+            freeRanges.clear();
+            if (newCapacity > 0) {
+                freeRanges[0] = newCapacity;
+            }
+            capacity = newCapacity;
+            used = 0;
+        }
+
+        bool GeometryArena::RangeAllocator::Allocate(size_t size, size_t alignment, size_t& outOffset)
+        {
+            for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+                size_t rangeStart = it->first;
+                size_t rangeSize = it->second;
+                size_t alignedStart = (rangeStart + alignment - 1) / alignment * alignment;
+                size_t padding = alignedStart - rangeStart;
+                if (rangeSize < padding + size) continue;
+
+                // Keep the alignment padding and the tail free
+                freeRanges.erase(it);
+                if (padding > 0) {
+                    freeRanges[rangeStart] = padding;
+                }
+                size_t tail = rangeSize - padding - size;
+                if (tail > 0) {
+                    freeRanges[alignedStart + size] = tail;
+                }
+
+                used += size;
+                outOffset = alignedStart;
+                return true;
+            }
+            return false;
+        }
+
+        void GeometryArena::RangeAllocator::Free(size_t offset, size_t size)
+        {
+            if (size == 0) return;
+            used -= size;
+
+            auto next = freeRanges.lower_bound(offset);
+            if (next != freeRanges.end() && offset + size == next->first) {
+                size += next->second;
+                next = freeRanges.erase(next);
+            }
+            if (next != freeRanges.begin()) {
+                auto previous = std::prev(next);
+                if (previous->first + previous->second == offset) {
+                    previous->second += size;
+                    return;
+                }
+            }
+            freeRanges[offset] = size;
+        }
+
+        void GeometryArena::RangeAllocator::Grow(size_t newCapacity)
+        {
+            if (newCapacity <= capacity) return;
+
+            size_t oldCapacity = capacity;
+            capacity = newCapacity;
+            // Free() counts the range as released, so pre-add it to the used total
+            used += newCapacity - oldCapacity;
+            Free(oldCapacity, newCapacity - oldCapacity);
+        }
+
+        GeometryArena& GeometryArena::GetInstance()
+        {
+            static GeometryArena instance;
+            return instance;
+        }
+
+        GLuint GeometryArena::ReallocateBuffer(GLuint oldBuffer, size_t copySize, size_t newSize)
+        {
+            // The copy targets are not VAO state, so no VAO has to be unbound for this
+            GLuint newBuffer = 0;
+            glGenBuffers(1, &newBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+            glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_STATIC_DRAW);
+
+            if (oldBuffer != 0) {
+                if (copySize > 0) {
+                    glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+                    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, copySize);
+                    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+                }
+                glDeleteBuffers(1, &oldBuffer);
+            }
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            return newBuffer;
+        }
+
+        void GeometryArena::CreatePool(VertexLayout layout)
+        {
+            VertexPool& pool = pools[static_cast<int>(layout)];
+            GLuint stride = static_cast<GLuint>(VertexPacker::GetStride(layout));
+
+            pool.vertexBuffer = ReallocateBuffer(0, 0, INITIAL_VERTEX_CAPACITY * stride);
+            pool.ranges.Reset(INITIAL_VERTEX_CAPACITY);
+
+            if (indexBuffer == 0) {
+                indexBuffer = ReallocateBuffer(0, 0, INITIAL_INDEX_CAPACITY);
+                indexRanges.Reset(INITIAL_INDEX_CAPACITY);
+            }
+
+            glGenVertexArrays(1, &pool.vertexArray);
+            GLStateCache& state = GLStateCache::GetInstance();
+            state.BindVertexArray(pool.vertexArray);
+
+            // Position (location 0): unorm16 in the mesh bounds
+            glVertexAttribFormat(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(StaticVertex, position));
+            // Normal (location 1): octahedral snorm16
+            glVertexAttribFormat(1, 2, GL_SHORT, GL_TRUE, offsetof(StaticVertex, normal));
+            // TexCoords (location 2): half float
+            glVertexAttribFormat(2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(StaticVertex, texCoords));
+            GLuint attributeCount = 3;
+
+            if (layout == VertexLayout::Skinned) {
+                // BoneIndices (location 3) stay integers; BoneWeights (location 4) are unorm16
+                glVertexAttribIFormat(3, 4, GL_UNSIGNED_BYTE, offsetof(SkinnedVertex, boneIndices));
+                glVertexAttribFormat(4, 4, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(SkinnedVertex, boneWeights));
+                attributeCount = 5;
+            }
+            // Static meshes leave locations 3 and 4 disabled; the shaders only read them when uHasAnimation is set
+
+            for (GLuint location = 0; location < attributeCount; location++) {
+                glVertexAttribBinding(location, VERTEX_BINDING_INDEX);
+                glEnableVertexAttribArray(location);
+            }
+            glBindVertexBuffer(VERTEX_BINDING_INDEX, pool.vertexBuffer, 0, stride);
+
+            InstanceBuffer::GetInstance().ConfigureVertexArray();
+
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+            // Leave no VAO bound so later element-buffer binds cannot land in this one
+            state.BindVertexArray(0);
+        }
+
+        void GeometryArena::GrowPool(VertexLayout layout, size_t requiredVertices)
+        {
+            VertexPool& pool = pools[static_cast<int>(layout)];
+            size_t stride = VertexPacker::GetStride(layout);
+
+            size_t newCapacity = pool.ranges.GetCapacity();
+            while (newCapacity < pool.ranges.GetCapacity() + requiredVertices) {
+                newCapacity *= 2;
+            }
+
+            pool.vertexBuffer = ReallocateBuffer(pool.vertexBuffer, pool.ranges.GetCapacity() * stride, newCapacity * stride);
+            pool.ranges.Grow(newCapacity);
+
+            GLStateCache& state = GLStateCache::GetInstance();
+            state.BindVertexArray(pool.vertexArray);
+            glBindVertexBuffer(VERTEX_BINDING_INDEX, pool.vertexBuffer, 0, static_cast<GLsizei>(stride));
+            state.BindVertexArray(0);
+        }
+
+        void GeometryArena::GrowIndexBuffer(size_t requiredBytes)
+        {
+            size_t newCapacity = indexRanges.GetCapacity();
+            while (newCapacity < indexRanges.GetCapacity() + requiredBytes + INDEX_ALIGNMENT) {
+                newCapacity *= 2;
+            }
+
+            indexBuffer = ReallocateBuffer(indexBuffer, indexRanges.GetCapacity(), newCapacity);
+            indexRanges.Grow(newCapacity);
+
+            // The element buffer is VAO state: point every pool at the new one
+            GLStateCache& state = GLStateCache::GetInstance();
+            for (VertexPool& pool : pools) {
+                if (pool.vertexArray == 0) continue;
+                state.BindVertexArray(pool.vertexArray);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            }
+            state.BindVertexArray(0);
+        }
+
+        bool GeometryArena::Allocate(VertexLayout layout, const void* vertexData, uint32_t vertexCount,
+            const std::vector<unsigned int>& indices, GeometryAllocation& outAllocation)
+        {
+            if (vertexCount == 0 || indices.empty()) {
+                RTB_ERROR("GeometryArena: Empty mesh");
+                return false;
+            }
+
+            VertexPool& pool = pools[static_cast<int>(layout)];
+            if (pool.vertexArray == 0) {
+                CreatePool(layout);
+            }
+
+            GeometryAllocation allocation;
+            allocation.layout = layout;
+            allocation.vertexCount = vertexCount;
+            allocation.indexCount = static_cast<uint32_t>(indices.size());
+            allocation.indexType = vertexCount <= MAX_SHORT_INDEX_VERTICES ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+            // Vertices: growing keeps existing offsets, so a retry after growth always succeeds
+            size_t vertexOffset = 0;
+            if (!pool.ranges.Allocate(vertexCount, 1, vertexOffset)) {
+                GrowPool(layout, vertexCount);
+                pool.ranges.Allocate(vertexCount, 1, vertexOffset);
+            }
+            allocation.baseVertex = static_cast<GLint>(vertexOffset);
+
+            size_t indexBytes = allocation.GetIndexBytes();
+            if (!indexRanges.Allocate(indexBytes, INDEX_ALIGNMENT, allocation.indexOffset)) {
+                GrowIndexBuffer(indexBytes);
+                indexRanges.Allocate(indexBytes, INDEX_ALIGNMENT, allocation.indexOffset);
+            }
+
+            size_t stride = VertexPacker::GetStride(layout);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, pool.vertexBuffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, vertexOffset * stride, vertexCount * stride, vertexData);
+
+            // Indices stay relative to the mesh; the draw adds baseVertex
+            glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+            if (allocation.indexType == GL_UNSIGNED_SHORT) {
+                shortIndices.assign(indices.begin(), indices.end());
+                glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.indexOffset, indexBytes, shortIndices.data());
+            }
+            else {
+                glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.indexOffset, indexBytes, indices.data());
+            }
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+            allocation.valid = true;
+            allocationCount++;
+            outAllocation = allocation;
+            return true;
+        }
+
+        void GeometryArena::Free(GeometryAllocation& allocation)
+        {
+            if (!allocation.valid) return;
+
+            // Meshes can outlive Shutdown (scene teardown order); their storage is already gone then
+            VertexPool& pool = pools[static_cast<int>(allocation.layout)];
+            if (pool.vertexArray != 0) {
+                pool.ranges.Free(static_cast<size_t>(allocation.baseVertex), allocation.vertexCount);
+                indexRanges.Free(allocation.indexOffset, allocation.GetIndexBytes());
+                allocationCount--;
+            }
+            allocation.valid = false;
+        }
+
+        bool GeometryArena::Read(const GeometryAllocation& allocation, uint32_t firstIndex, uint32_t indexCount,
+            std::vector<uint8_t>& outVertexData, std::vector<unsigned int>& outIndices) const
+        {
+            const VertexPool& pool = pools[static_cast<int>(allocation.layout)];
+            if (!allocation.valid || pool.vertexBuffer == 0 || firstIndex + indexCount > allocation.indexCount) {
+                return false;
+            }
+
+            size_t stride = VertexPacker::GetStride(allocation.layout);
+            outVertexData.resize(allocation.vertexCount * stride);
+            glBindBuffer(GL_COPY_READ_BUFFER, pool.vertexBuffer);
+            glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<size_t>(allocation.baseVertex) * stride,
+                outVertexData.size(), outVertexData.data());
+
+            size_t indexSize = allocation.GetIndexSize();
+            GLintptr indexOffset = static_cast<GLintptr>(allocation.indexOffset + firstIndex * indexSize);
+            outIndices.resize(indexCount);
+            glBindBuffer(GL_COPY_READ_BUFFER, indexBuffer);
+            if (allocation.indexType == GL_UNSIGNED_SHORT) {
+                std::vector<uint16_t> shorts(indexCount);
+                glGetBufferSubData(GL_COPY_READ_BUFFER, indexOffset, indexCount * indexSize, shorts.data());
+                outIndices.assign(shorts.begin(), shorts.end());
+            }
+            else {
+                glGetBufferSubData(GL_COPY_READ_BUFFER, indexOffset, indexCount * indexSize, outIndices.data());
+            }
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            return true;
+        }
+
+        size_t GeometryArena::GetVertexBytesUsed() const
+        {
+            size_t bytes = 0;
+            for (int layout = 0; layout < LAYOUT_COUNT; ++layout) {
+                bytes += pools[layout].ranges.GetUsed() * VertexPacker::GetStride(static_cast<VertexLayout>(layout));
+            }
+            return bytes;
+        }
+
+        size_t GeometryArena::GetVertexBytesCapacity() const
+        {
+            size_t bytes = 0;
+            for (int layout = 0; layout < LAYOUT_COUNT; ++layout) {
+                bytes += pools[layout].ranges.GetCapacity() * VertexPacker::GetStride(static_cast<VertexLayout>(layout));
+            }
+            return bytes;
+        }
+
+        void GeometryArena::Shutdown()
+        {
+            GLStateCache& state = GLStateCache::GetInstance();
+            for (VertexPool& pool : pools) {
+                if (pool.vertexArray != 0) {
+                    glDeleteVertexArrays(1, &pool.vertexArray);
+                    state.OnVertexArrayDeleted(pool.vertexArray);
+                }
+                if (pool.vertexBuffer != 0) {
+                    glDeleteBuffers(1, &pool.vertexBuffer);
+                }
+                pool = VertexPool();
+            }
+
+            if (indexBuffer != 0) {
+                glDeleteBuffers(1, &indexBuffer);
+                indexBuffer = 0;
+            }
+            indexRanges.Reset(0);
+            allocationCount = 0;
+        }
+
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <GL/glew.h>
+#include "VertexFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Where a mesh lives inside the arena
+        struct GeometryAllocation {
+            VertexLayout layout = VertexLayout::Static;
+            GLint baseVertex = 0;           // first vertex in the layout's vertex buffer
+            uint32_t vertexCount = 0;
+            size_t indexOffset = 0;         // byte offset into the shared index buffer
+            uint32_t indexCount = 0;
+            GLenum indexType = GL_UNSIGNED_INT;
+            bool valid = false;
+
+            size_t GetIndexSize() const { return indexType == GL_UNSIGNED_SHORT ? 2u : 4u; }
+            size_t GetIndexBytes() const { return indexCount * GetIndexSize(); }
+        };
+
+        // Shared geometry storage for every mesh: one vertex buffer and VAO per VertexLayout plus one
+        // index buffer, sub-allocated with a first-fit free list. Meshes of the same layout share a
+        // VAO and draw with base-vertex offsets, so switching meshes binds nothing.
+        class GeometryArena {
+        public:
+            static constexpr GLuint VERTEX_BINDING_INDEX = 0;
+            static constexpr size_t INITIAL_VERTEX_CAPACITY = 64 * 1024;    // vertices per layout
+            static constexpr size_t INITIAL_INDEX_CAPACITY = 1024 * 1024;   // bytes
+            static constexpr uint32_t MAX_SHORT_INDEX_VERTICES = 65536;
+
+            static GeometryArena& GetInstance();
+
+            GeometryArena(const GeometryArena&) = delete;
+            GeometryArena& operator=(const GeometryArena&) = delete;
+
+            // Uploads packed vertices (GetStride(layout) bytes each) and indices; the indices are stored
+            // as 16-bit when the mesh has at most 65536 vertices. Requires a GL context.
+            bool Allocate(VertexLayout layout, const void* vertexData, uint32_t vertexCount,
+                const std::vector<unsigned int>& indices, GeometryAllocation& outAllocation);
+            void Free(GeometryAllocation& allocation);
+
+            // Reads back the packed vertices and indexCount indices from firstIndex (relative to the
+            // allocation). Waits for the GPU; meant for one-off CPU copies, not per-frame use.
+            bool Read(const GeometryAllocation& allocation, uint32_t firstIndex, uint32_t indexCount,
+                std::vector<uint8_t>& outVertexData, std::vector<unsigned int>& outIndices) const;
+
+            GLuint GetVertexArray(VertexLayout layout) const { return pools[static_cast<int>(layout)].vertexArray; }
+
+            size_t GetVertexBytesUsed() const;
+            size_t GetVertexBytesCapacity() const;
+            size_t GetIndexBytesUsed() const { return indexRanges.GetUsed(); }
+            size_t GetIndexBytesCapacity() const { return indexRanges.GetCapacity(); }
+            size_t GetAllocationCount() const { return allocationCount; }
+
+            void Shutdown();
+
+        private:
+            GeometryArena() = default;
+            ~GeometryArena() = default;
+
+            // First-fit allocator over [0, capacity) with coalescing frees
+            class RangeAllocator {
+            public:
+                void Reset(size_t capacity);
+                bool Allocate(size_t size, size_t alignment, size_t& outOffset);
+                void Free(size_t offset, size_t size);
+                // Adds [capacity, newCapacity) to the free list
+                void Grow(size_t newCapacity);
+
+                size_t GetUsed() const { return used; }
+                size_t GetCapacity() const { return capacity; }
+
+            private:
+                std::map<size_t, size_t> freeRanges;   // offset -> size
+                size_t capacity = 0;
+                size_t used = 0;
+            };
+
+            struct VertexPool {
+                GLuint vertexArray = 0;
+                GLuint vertexBuffer = 0;
+                RangeAllocator ranges;      // in vertices, so offsets are base vertices
+            };
+
+            static constexpr int LAYOUT_COUNT = 2;
+
+            void CreatePool(VertexLayout layout);
+            void GrowPool(VertexLayout layout, size_t requiredVertices);
+            void GrowIndexBuffer(size_t requiredBytes);
+
+            // Creates a buffer of newSize bytes holding the first copySize bytes of oldBuffer
+            static GLuint ReallocateBuffer(GLuint oldBuffer, size_t copySize, size_t newSize);
+
+            VertexPool pools[LAYOUT_COUNT];
+            GLuint indexBuffer = 0;
+            RangeAllocator indexRanges;
+            size_t allocationCount = 0;
+            std::vector<uint16_t> shortIndices;     // conversion scratch
+        };
+
+    }
+}
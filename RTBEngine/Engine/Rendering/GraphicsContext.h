@@ -0,0 +1,18 @@
+#pragma once
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Whether a GL context exists. Cleared in headless mode: GPU resources skip their uploads
+        // and meshes keep their CPU-side data instead.
+        class GraphicsContext {
+        public:
+            static bool IsAvailable() { return available; }
+            static void SetAvailable(bool value) { available = value; }
+
+        private:
+            static inline bool available = true;
+        };
+
+    }
+}
@@ -0,0 +1,84 @@
+#include "IndirectDrawBuffer.h"
+#include "GeometryArena.h"
+#include "InstanceBuffer.h"
+#include "GLStateCache.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static_assert(sizeof(DrawElementsIndirectCommand) == 5 * sizeof(uint32_t), "Indirect commands are read as five packed uints");
+
+        IndirectDrawBuffer& IndirectDrawBuffer::GetInstance()
+        {
+            static IndirectDrawBuffer instance;
+            return instance;
+        }
+
+        bool IndirectDrawBuffer::IsSupported()
+        {
+            return GLEW_VERSION_4_3 || (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance);
+        }
+
+        void IndirectDrawBuffer::SetEnabled(bool enable)
+        {
+            enabled = enable && IsSupported();
+        }
+
+        void IndirectDrawBuffer::Allocate(size_t newCapacity)
+        {
+            // GL_DRAW_INDIRECT_BUFFER is context state, not VAO state, so binding it here is harmless
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, bufferID);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, newCapacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+            capacity = newCapacity;
+            cursor = 0;
+        }
+
+        void IndirectDrawBuffer::BeginFrame()
+        {
+            if (bufferID == 0) return;
+
+            Allocate(capacity);
+        }
+
+        void IndirectDrawBuffer::Draw(VertexLayout layout, GLenum indexType, const DrawElementsIndirectCommand* commands, size_t count)
+        {
+            if (count == 0) return;
+
+            if (bufferID == 0) {
+                glGenBuffers(1, &bufferID);
+                Allocate(INITIAL_CAPACITY);
+            }
+
+            if (cursor + count > capacity) {
+                // Same policy as InstanceBuffer: grow and restart on fresh storage
+                size_t newCapacity = capacity;
+                while (newCapacity < cursor + count) {
+                    newCapacity *= 2;
+                }
+                Allocate(newCapacity);
+            }
+
+            size_t offset = cursor * sizeof(DrawElementsIndirectCommand);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, bufferID);
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, offset, count * sizeof(DrawElementsIndirectCommand), commands);
+            cursor += count;
+
+            // baseInstance counts records from the start of the instance buffer
+            GLStateCache::GetInstance().BindVertexArray(GeometryArena::GetInstance().GetVertexArray(layout));
+            glBindVertexBuffer(InstanceBuffer::BINDING_INDEX, InstanceBuffer::GetInstance().GetBufferID(), 0, sizeof(InstanceData));
+            glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, reinterpret_cast<void*>(offset),
+                static_cast<GLsizei>(count), 0);
+        }
+
+        void IndirectDrawBuffer::Shutdown()
+        {
+            if (bufferID != 0) {
+                glDeleteBuffers(1, &bufferID);
+                bufferID = 0;
+            }
+            capacity = 0;
+            cursor = 0;
+        }
+
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <GL/glew.h>
+#include "VertexFormat.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Layout fixed by glMultiDrawElementsIndirect
+        struct DrawElementsIndirectCommand {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t firstIndex;        // in indices of the draw's index type
+            int32_t baseVertex;
+            uint32_t baseInstance;      // first InstanceData record for this command
+        };
+
+        // Streaming GL_DRAW_INDIRECT_BUFFER for multi-draw indirect over the GeometryArena. Per-draw data
+        // (model matrix, position dequantization) is read from InstanceBuffer through baseInstance,
+        // which works on GL 4.3 without gl_DrawID. Written linearly and orphaned every frame.
+        class IndirectDrawBuffer {
+        public:
+            static constexpr size_t INITIAL_CAPACITY = 1024;   // commands
+
+            static IndirectDrawBuffer& GetInstance();
+
+            IndirectDrawBuffer(const IndirectDrawBuffer&) = delete;
+            IndirectDrawBuffer& operator=(const IndirectDrawBuffer&) = delete;
+
+            // Multi-draw indirect with honoured baseInstance (GL 4.3, or the ARB extensions)
+            static bool IsSupported();
+
+            // Stays off when the context does not support it; RenderQueue then draws mesh by mesh
+            void SetEnabled(bool enable);
+            bool IsEnabled() const { return enabled; }
+
+            void BeginFrame();
+
+            // Uploads the commands and draws them with one call on the arena VAO of layout
+            void Draw(VertexLayout layout, GLenum indexType, const DrawElementsIndirectCommand* commands, size_t count);
+
+            void Shutdown();
+
+        private:
+            IndirectDrawBuffer() = default;
+            ~IndirectDrawBuffer() = default;
+
+            void Allocate(size_t capacity);
+
+            GLuint bufferID = 0;
+            size_t capacity = 0;
+            size_t cursor = 0;
+            bool enabled = false;
+        };
+
+    }
+}
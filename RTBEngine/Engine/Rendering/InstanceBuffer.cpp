@@ -0,0 +1,88 @@
+#include "InstanceBuffer.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static_assert(sizeof(InstanceData) == 24 * sizeof(float), "Instance data is uploaded as a raw mat4 and two vec4s");
+
+        InstanceBuffer& InstanceBuffer::GetInstance()
+        {
+            static InstanceBuffer instance;
+            return instance;
+        }
+
+        GLuint InstanceBuffer::GetBufferID()
+        {
+            if (bufferID == 0) {
+                glGenBuffers(1, &bufferID);
+                Allocate(INITIAL_CAPACITY);
+            }
+            return bufferID;
+        }
+
+        void InstanceBuffer::Allocate(size_t newCapacity)
+        {
+            // Re-specifying the store keeps the buffer name, so VAOs that reference it stay valid;
+            // draws already queued keep reading the old storage
+            glBindBuffer(GL_ARRAY_BUFFER, bufferID);
+            glBufferData(GL_ARRAY_BUFFER, newCapacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            capacity = newCapacity;
+            cursor = 0;
+        }
+
+        void InstanceBuffer::BeginFrame()
+        {
+            if (bufferID == 0) return;
+
+            Allocate(capacity);
+        }
+
+        GLintptr InstanceBuffer::Write(const InstanceData* instances, size_t count)
+        {
+            GetBufferID();
+
+            if (cursor + count > capacity) {
+                // Grow so a frame of this size fits next time; restarts at offset 0 on fresh storage
+                size_t newCapacity = capacity;
+                while (newCapacity < cursor + count) {
+                    newCapacity *= 2;
+                }
+                Allocate(newCapacity);
+            }
+
+            GLintptr offset = static_cast<GLintptr>(cursor * sizeof(InstanceData));
+            glBindBuffer(GL_ARRAY_BUFFER, bufferID);
+            glBufferSubData(GL_ARRAY_BUFFER, offset, count * sizeof(InstanceData), instances);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            cursor += count;
+            return offset;
+        }
+
+        void InstanceBuffer::ConfigureVertexArray()
+        {
+            // Model matrix columns, then scale and bias; all vec4s advanced once per instance.
+            // Bound to this buffer from the start so non-instanced draws never see an empty binding.
+            for (GLuint i = 0; i < ATTRIBUTE_COUNT; i++) {
+                GLuint location = FIRST_ATTRIBUTE + i;
+                glVertexAttribFormat(location, 4, GL_FLOAT, GL_FALSE, i * sizeof(float) * 4);
+                glVertexAttribBinding(location, BINDING_INDEX);
+                glEnableVertexAttribArray(location);
+            }
+            glVertexBindingDivisor(BINDING_INDEX, 1);
+            glBindVertexBuffer(BINDING_INDEX, GetBufferID(), 0, sizeof(InstanceData));
+        }
+
+        void InstanceBuffer::Shutdown()
+        {
+            if (bufferID != 0) {
+                glDeleteBuffers(1, &bufferID);
+                bufferID = 0;
+            }
+            capacity = 0;
+            cursor = 0;
+        }
+
+    }
+}
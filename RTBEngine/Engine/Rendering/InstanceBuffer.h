@@ -0,0 +1,58 @@
+#pragma once
+#include <GL/glew.h>
+#include "../Math/Math.h"
+#include <cstddef>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Per-instance vertex data: model matrix (locations 5-8) and the mesh's position
+        // dequantization (locations 9-10), since one indirect draw can cover several meshes
+        struct InstanceData {
+            Math::Matrix4 model;
+            float positionScale[4];     // xyz
+            float positionBias[4];      // xyz
+        };
+
+        // Streaming vertex buffer for per-instance data.
+        // Every GeometryArena VAO points its instance binding at this buffer, so instanced draws only need
+        // to rebind the offset. Written linearly during a frame and orphaned at the start of the next.
+        class InstanceBuffer {
+        public:
+            // Vertex buffer binding index used for instance data (kept clear of the per-vertex attribute indices)
+            static constexpr GLuint BINDING_INDEX = 5;
+            static constexpr GLuint FIRST_ATTRIBUTE = 5;
+            static constexpr GLuint ATTRIBUTE_COUNT = 6;
+            static constexpr size_t INITIAL_CAPACITY = 4096;
+
+            static InstanceBuffer& GetInstance();
+
+            InstanceBuffer(const InstanceBuffer&) = delete;
+            InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+            // Creates the buffer on first use; requires a GL context
+            GLuint GetBufferID();
+
+            void BeginFrame();
+
+            // Copies instances into the buffer and returns their byte offset (a multiple of sizeof(InstanceData))
+            GLintptr Write(const InstanceData* instances, size_t count);
+
+            // Sets up the instance attributes and binding on the currently bound VAO
+            void ConfigureVertexArray();
+
+            void Shutdown();
+
+        private:
+            InstanceBuffer() = default;
+            ~InstanceBuffer() = default;
+
+            void Allocate(size_t capacity);
+
+            GLuint bufferID = 0;
+            size_t capacity = 0;
+            size_t cursor = 0;
+        };
+
+    }
+}
@@ -0,0 +1,227 @@
+#include "LightClusters.h"
+#include "Camera.h"
+#include "Lighting/Light.h"
+#include "Lighting/PointLight.h"
+#include "Lighting/SpotLight.h"
+#include <algorithm>
+#include <cmath>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static_assert(sizeof(LocalLightData) == 64, "LocalLightData must match the std430 LocalLight");
+        static_assert(sizeof(ClusterUniforms) == 32, "ClusterUniforms must match the std140 ClusterBlock");
+
+        // Point lights have no cone; any value below -1 disables the spot test in the shader
+        static constexpr float NO_CONE = -2.0f;
+
+        static void StoreVec4(float* out, const Math::Vector3& v, float w)
+        {
+            out[0] = v.x;
+            out[1] = v.y;
+            out[2] = v.z;
+            out[3] = w;
+        }
+
+        static bool SphereIntersectsAABB(const Math::Vector3& center, float radius, const Math::AABB& box)
+        {
+            float distanceSq = 0.0f;
+            const float c[3] = { center.x, center.y, center.z };
+            const float mn[3] = { box.min.x, box.min.y, box.min.z };
+            const float mx[3] = { box.max.x, box.max.y, box.max.z };
+            for (int axis = 0; axis < 3; ++axis) {
+                if (c[axis] < mn[axis]) distanceSq += (mn[axis] - c[axis]) * (mn[axis] - c[axis]);
+                else if (c[axis] > mx[axis]) distanceSq += (c[axis] - mx[axis]) * (c[axis] - mx[axis]);
+            }
+            return distanceSq <= radius * radius;
+        }
+
+        LightClusters::LightClusters()
+            : boundsKey{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, nearPlane(0.1f), farPlane(100.0f)
+        {
+        }
+
+        bool LightClusters::Initialize()
+        {
+            return clusterUniformBuffer.Initialize(CLUSTER_UNIFORM_BINDING, sizeof(ClusterUniforms))
+                && lightBuffer.Initialize(LOCAL_LIGHT_STORAGE_BINDING, 64 * sizeof(LocalLightData))
+                && rangeBuffer.Initialize(CLUSTER_RANGE_STORAGE_BINDING, CLUSTER_COUNT * 2 * sizeof(uint32_t))
+                && indexBuffer.Initialize(CLUSTER_INDEX_STORAGE_BINDING, CLUSTER_COUNT * 8 * sizeof(uint32_t));
+        }
+
+        void LightClusters::Shutdown()
+        {
+            clusterUniformBuffer.Shutdown();
+            lightBuffer.Shutdown();
+            rangeBuffer.Shutdown();
+            indexBuffer.Shutdown();
+        }
+
+        void LightClusters::BuildClusterBounds(const Camera& camera)
+        {
+            bool perspective = camera.GetProjectionType() == ProjectionType::Perspective;
+            float key[6] = { perspective ? 1.0f : 0.0f, camera.GetFOV(), camera.GetAspectRatio(),
+                camera.GetNearPlane(), camera.GetFarPlane(), camera.GetOrthographicSize() };
+            if (!clusterBounds.empty() && std::equal(key, key + 6, boundsKey)) {
+                return;
+            }
+            std::copy(key, key + 6, boundsKey);
+
+            nearPlane = std::max(camera.GetNearPlane(), 0.001f);
+            farPlane = std::max(camera.GetFarPlane(), nearPlane * 1.001f);
+
+            // Half extents of the view volume per unit of depth (perspective) or absolute (orthographic)
+            float halfHeight = perspective
+                ? std::tan(camera.GetFOV() * 3.14159265f / 180.0f * 0.5f)
+                : camera.GetOrthographicSize() * 0.5f;
+            float halfWidth = halfHeight * camera.GetAspectRatio();
+
+            clusterBounds.assign(CLUSTER_COUNT, Math::AABB());
+            for (uint32_t z = 0; z < GRID_Z; ++z) {
+                float depths[2] = {
+                    nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z) / GRID_Z),
+                    nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z + 1) / GRID_Z)
+                };
+
+                for (uint32_t y = 0; y < GRID_Y; ++y) {
+                    float ndcY[2] = { -1.0f + 2.0f * y / GRID_Y, -1.0f + 2.0f * (y + 1) / GRID_Y };
+
+                    for (uint32_t x = 0; x < GRID_X; ++x) {
+                        float ndcX[2] = { -1.0f + 2.0f * x / GRID_X, -1.0f + 2.0f * (x + 1) / GRID_X };
+
+                        Math::AABB& bounds = clusterBounds[GetClusterIndex(x, y, z)];
+                        for (float depth : depths) {
+                            float scale = perspective ? depth : 1.0f;
+                            for (float nx : ndcX) {
+                                for (float ny : ndcY) {
+                                    bounds.Expand(Math::Vector3(nx * halfWidth * scale, ny * halfHeight * scale, -depth));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        uint32_t LightClusters::GetSlice(float viewDepth) const
+        {
+            float slice = std::log(viewDepth / nearPlane) / std::log(farPlane / nearPlane) * GRID_Z;
+            return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(GRID_Z - 1)));
+        }
+
+        void LightClusters::Update(const std::vector<Light*>& lights, Camera* camera, int viewportWidth, int viewportHeight)
+        {
+            lightData.clear();
+            assignments.clear();
+
+            if (camera) {
+                BuildClusterBounds(*camera);
+                const Math::Matrix4& view = camera->GetViewMatrix();
+
+                for (Light* light : lights) {
+                    if (!light) continue;
+
+                    LocalLightData data;
+                    float range = 0.0f;
+                    Math::Vector3 position;
+
+                    if (light->GetType() == LightType::Point) {
+                        auto* pointLight = static_cast<PointLight*>(light);
+                        position = pointLight->GetPosition();
+                        range = pointLight->GetRange();
+                        StoreVec4(data.positionRange, position, range);
+                        StoreVec4(data.colorIntensity, pointLight->GetColor(), pointLight->GetIntensity());
+                        StoreVec4(data.directionInnerCutOff, Math::Vector3(0.0f, 0.0f, 0.0f), 1.0f);
+                        StoreVec4(data.attenuationOuterCutOff, Math::Vector3(pointLight->GetConstant(),
+                            pointLight->GetLinear(), pointLight->GetQuadratic()), NO_CONE);
+                    }
+                    else if (light->GetType() == LightType::Spot) {
+                        auto* spotLight = static_cast<SpotLight*>(light);
+                        position = spotLight->GetPosition();
+                        range = spotLight->GetRange();
+                        StoreVec4(data.positionRange, position, range);
+                        StoreVec4(data.colorIntensity, spotLight->GetColor(), spotLight->GetIntensity());
+                        StoreVec4(data.directionInnerCutOff, spotLight->GetDirection(), spotLight->GetInnerCutOff());
+                        StoreVec4(data.attenuationOuterCutOff, Math::Vector3(spotLight->GetConstant(),
+                            spotLight->GetLinear(), spotLight->GetQuadratic()), spotLight->GetOuterCutOff());
+                    }
+                    else {
+                        continue;
+                    }
+
+                    // Spot lights are bounded by their range sphere, which is conservative for the cone
+                    Math::Vector4 viewPosition = view * Math::Vector4(position.x, position.y, position.z, 1.0f);
+                    Math::Vector3 center(viewPosition.x, viewPosition.y, viewPosition.z);
+                    float depth = -center.z;
+                    if (range <= 0.0f || depth + range < nearPlane || depth - range > farPlane) continue;
+
+                    uint32_t lightIndex = static_cast<uint32_t>(lightData.size());
+                    lightData.push_back(data);
+
+                    uint32_t firstSlice = GetSlice(std::max(depth - range, nearPlane));
+                    uint32_t lastSlice = GetSlice(std::min(depth + range, farPlane));
+
+                    for (uint32_t z = firstSlice; z <= lastSlice; ++z) {
+                        // Rows and columns share their y / x extents within a slice, so narrow those first
+                        uint32_t firstRow = GRID_Y, lastRow = 0;
+                        for (uint32_t y = 0; y < GRID_Y; ++y) {
+                            const Math::AABB& row = clusterBounds[GetClusterIndex(0, y, z)];
+                            if (center.y + range >= row.min.y && center.y - range <= row.max.y) {
+                                firstRow = std::min(firstRow, y);
+                                lastRow = y;
+                            }
+                        }
+                        if (firstRow > lastRow) continue;
+
+                        for (uint32_t x = 0; x < GRID_X; ++x) {
+                            const Math::AABB& column = clusterBounds[GetClusterIndex(x, 0, z)];
+                            if (center.x + range < column.min.x || center.x - range > column.max.x) continue;
+
+                            for (uint32_t y = firstRow; y <= lastRow; ++y) {
+                                uint32_t cluster = GetClusterIndex(x, y, z);
+                                if (SphereIntersectsAABB(center, range, clusterBounds[cluster])) {
+                                    assignments.push_back(cluster);
+                                    assignments.push_back(lightIndex);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Counting sort of the (cluster, light) pairs into contiguous per-cluster lists
+            clusterRanges.assign(CLUSTER_COUNT * 2, 0);
+            for (size_t i = 0; i < assignments.size(); i += 2) {
+                clusterRanges[assignments[i] * 2 + 1]++;
+            }
+            uint32_t offset = 0;
+            for (uint32_t cluster = 0; cluster < CLUSTER_COUNT; ++cluster) {
+                clusterRanges[cluster * 2] = offset;
+                offset += clusterRanges[cluster * 2 + 1];
+                clusterRanges[cluster * 2 + 1] = 0;
+            }
+            lightIndices.resize(offset);
+            for (size_t i = 0; i < assignments.size(); i += 2) {
+                uint32_t* range = &clusterRanges[assignments[i] * 2];
+                lightIndices[range[0] + range[1]++] = assignments[i + 1];
+            }
+
+            ClusterUniforms uniforms;
+            uniforms.grid[0] = GRID_X;
+            uniforms.grid[1] = GRID_Y;
+            uniforms.grid[2] = GRID_Z;
+            uniforms.grid[3] = static_cast<uint32_t>(lightData.size());
+            float logRatio = std::log(farPlane / nearPlane);
+            uniforms.params[0] = static_cast<float>(std::max(viewportWidth, 1)) / GRID_X;
+            uniforms.params[1] = static_cast<float>(std::max(viewportHeight, 1)) / GRID_Y;
+            uniforms.params[2] = GRID_Z / logRatio;
+            uniforms.params[3] = GRID_Z * std::log(nearPlane) / logRatio;
+
+            clusterUniformBuffer.Update(&uniforms, sizeof(uniforms));
+            lightBuffer.Upload(lightData.data(), lightData.size() * sizeof(LocalLightData));
+            rangeBuffer.Upload(clusterRanges.data(), clusterRanges.size() * sizeof(uint32_t));
+            indexBuffer.Upload(lightIndices.data(), lightIndices.size() * sizeof(uint32_t));
+        }
+
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "UniformBuffer.h"
+#include "ShaderStorageBuffer.h"
+#include "../Math/Math.h"
+#include "../Math/Geometry/AABB.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        class Camera;
+        class Light;
+
+        // Binding points shared with basic.frag
+        constexpr GLuint CLUSTER_UNIFORM_BINDING = 3;   // uniform block
+        constexpr GLuint LOCAL_LIGHT_STORAGE_BINDING = 4;
+        constexpr GLuint CLUSTER_RANGE_STORAGE_BINDING = 5;
+        constexpr GLuint CLUSTER_INDEX_STORAGE_BINDING = 6;
+
+        // One point or spot light as read by the shader (std430, vec4s only)
+        struct LocalLightData {
+            float positionRange[4];         // world position, range
+            float colorIntensity[4];        // rgb, intensity
+            float directionInnerCutOff[4];  // xyz, cos(inner angle)
+            float attenuationOuterCutOff[4];// constant, linear, quadratic, cos(outer angle); point lights use -2
+        };
+
+        struct ClusterUniforms {
+            uint32_t grid[4];               // clusters in x, y, z; number of local lights
+            float params[4];                // tile width, tile height (pixels), slice scale, slice bias
+        };
+
+        // Clustered forward lighting. The view frustum is divided into a GRID_X x GRID_Y x GRID_Z froxel
+        // grid (screen tiles by exponential depth slices); every point and spot light is assigned, by
+        // range, to the froxels it touches. The fragment shader finds its froxel from gl_FragCoord and
+        // view depth and only evaluates the lights listed there.
+        class LightClusters {
+        public:
+            static constexpr uint32_t GRID_X = 16;
+            static constexpr uint32_t GRID_Y = 9;
+            static constexpr uint32_t GRID_Z = 24;
+            static constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+
+            LightClusters();
+
+            bool Initialize();
+            void Shutdown();
+
+            // Builds the per-cluster light lists for this camera and uploads them
+            void Update(const std::vector<Light*>& lights, Camera* camera, int viewportWidth, int viewportHeight);
+
+            size_t GetLightCount() const { return lightData.size(); }
+            size_t GetIndexCount() const { return lightIndices.size(); }
+
+        private:
+            // View-space bounds of every cluster; only rebuilt when the projection changes
+            void BuildClusterBounds(const Camera& camera);
+            uint32_t GetSlice(float viewDepth) const;
+
+            static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) {
+                return x + y * GRID_X + z * GRID_X * GRID_Y;
+            }
+
+            std::vector<Math::AABB> clusterBounds;
+            float boundsKey[6];             // projection parameters the bounds were built for
+            float nearPlane;
+            float farPlane;
+
+            std::vector<LocalLightData> lightData;
+            std::vector<uint32_t> clusterRanges;    // offset, count per cluster (uvec2)
+            std::vector<uint32_t> lightIndices;
+            std::vector<uint32_t> assignments;      // cluster, light pairs before sorting by cluster
+
+            UniformBuffer clusterUniformBuffer;
+            ShaderStorageBuffer lightBuffer;
+            ShaderStorageBuffer rangeBuffer;
+            ShaderStorageBuffer indexBuffer;
+        };
+
+    }
+}
@@ -1,66 +1,138 @@
 #include "DirectionalLight.h"
+#include "../Camera.h"
+#include <algorithm>
+#include <cmath>
 
 namespace RTBEngine {
     namespace Rendering {
 
         DirectionalLight::DirectionalLight()
-            : Light(LightType::Directional), direction(0.0f, -1.0f, 0.0f), castShadows(true), shadowBias(0.005f)
+            : Light(LightType::Directional), direction(0.0f, -1.0f, 0.0f), castShadows(true), shadowBias(0.005f),
+            cascadeCount(MAX_SHADOW_CASCADES), shadowDistance(100.0f), cascadeSplitLambda(0.75f)
         {
         }
 
 
         DirectionalLight::DirectionalLight(const Math::Vector3& direction, const Math::Vector3& color)
-            : Light(LightType::Directional), direction(direction.Normalized()), castShadows(true), shadowBias(0.005f)
+            : Light(LightType::Directional), direction(direction.Normalized()), castShadows(true), shadowBias(0.005f),
+            cascadeCount(MAX_SHADOW_CASCADES), shadowDistance(100.0f), cascadeSplitLambda(0.75f)
         {
             this->color = color;
         }
 
-        void DirectionalLight::ApplyToShader(Shader* shader)
-        {
-            if (shader) {
-                shader->SetVector3("dirLight.direction", direction);
-                shader->SetVector3("dirLight.color", color);
-                shader->SetFloat("dirLight.intensity", intensity);
-            }
-        }
-
         void DirectionalLight::SetCastShadows(bool enabled) {
             castShadows = enabled;
 
             if (enabled && !shadowMap) {
-                shadowMap = std::make_unique<ShadowMap>(2048);
-                shadowMap->Initialize();
+                CreateShadowMap(2048);
             }
         }
 
         void DirectionalLight::SetShadowMapResolution(int resolution) {
-            shadowMap = std::make_unique<ShadowMap>(resolution);
-            shadowMap->Initialize();
+            CreateShadowMap(resolution);
         }
 
         int DirectionalLight::GetShadowMapResolution() const {
             return shadowMap ? shadowMap->GetResolution() : 0;
         }
 
-        Math::Matrix4 DirectionalLight::GetLightSpaceMatrix(const Math::Vector3& sceneCenter, float sceneRadius) const {
-            Math::Vector3 lightPos = sceneCenter - direction.Normalized() * sceneRadius;
+        void DirectionalLight::SetShadowCascadeCount(int count) {
+            count = std::clamp(count, 1, MAX_SHADOW_CASCADES);
+            if (count == cascadeCount) return;
+
+            cascadeCount = count;
+            if (shadowMap) {
+                CreateShadowMap(shadowMap->GetResolution());
+            }
+        }
+
+        void DirectionalLight::CreateShadowMap(int resolution) {
+            shadowMap = std::make_unique<ShadowMap>(resolution, cascadeCount);
+            shadowMap->Initialize();
+        }
+
+        void DirectionalLight::UpdateCascades(const Camera& camera) {
+            float nearPlane = camera.GetNearPlane();
+            float farPlane = std::min(camera.GetFarPlane(), shadowDistance);
+            float resolution = static_cast<float>(shadowMap ? shadowMap->GetResolution() : 1024);
+
+            // Half extents of the view frustum per unit of distance (constant for orthographic cameras)
+            bool perspective = camera.GetProjectionType() == ProjectionType::Perspective;
+            float halfHeight = perspective
+                ? std::tan(camera.GetFOV() * 3.14159265f / 180.0f * 0.5f)
+                : camera.GetOrthographicSize() * 0.5f;
+            float halfWidth = halfHeight * camera.GetAspectRatio();
 
-            Math::Vector3 up(0.0f, 1.0f, 0.0f);
-            if (abs(direction.y) > 0.99f) {
-                up = Math::Vector3(1.0f, 0.0f, 0.0f);
+            Math::Vector3 position = camera.GetPosition();
+            Math::Vector3 forward = camera.GetForward();
+            Math::Vector3 right = camera.GetRight();
+            Math::Vector3 up = camera.GetUp();
+
+            // Fixed light orientation at the origin; only the projection follows the camera
+            Math::Vector3 lightUp(0.0f, 1.0f, 0.0f);
+            if (std::abs(direction.y) > 0.99f) {
+                lightUp = Math::Vector3(1.0f, 0.0f, 0.0f);
             }
+            Math::Matrix4 lightView = Math::Matrix4::LookAt(Math::Vector3(0.0f, 0.0f, 0.0f), direction, lightUp);
+
+            float splitNear = nearPlane;
+            for (int i = 0; i < cascadeCount; ++i) {
+                // Practical split scheme: blend of logarithmic and uniform distribution
+                float fraction = static_cast<float>(i + 1) / static_cast<float>(cascadeCount);
+                float logSplit = nearPlane * std::pow(farPlane / nearPlane, fraction);
+                float uniformSplit = nearPlane + (farPlane - nearPlane) * fraction;
+                float splitFar = cascadeSplitLambda * logSplit + (1.0f - cascadeSplitLambda) * uniformSplit;
 
-            Math::Matrix4 lightView = Math::Matrix4::LookAt(lightPos, sceneCenter, up);
+                Math::Vector3 corners[8];
+                float distances[2] = { splitNear, splitFar };
+                for (int d = 0; d < 2; ++d) {
+                    float scale = perspective ? distances[d] : 1.0f;
+                    Math::Vector3 center = position + forward * distances[d];
+                    Math::Vector3 x = right * (halfWidth * scale);
+                    Math::Vector3 y = up * (halfHeight * scale);
+                    corners[d * 4 + 0] = center - x - y;
+                    corners[d * 4 + 1] = center + x - y;
+                    corners[d * 4 + 2] = center + x + y;
+                    corners[d * 4 + 3] = center - x + y;
+                }
 
-            float orthoSize = sceneRadius;
-            Math::Matrix4 lightProjection = Math::Matrix4::Orthographic(
-                -orthoSize, orthoSize,
-                -orthoSize, orthoSize,
-                0.1f, sceneRadius * 3.0f
-            );
+                // A bounding sphere keeps the projection size constant while the camera rotates
+                Math::Vector3 sphereCenter(0.0f, 0.0f, 0.0f);
+                for (const Math::Vector3& corner : corners) {
+                    sphereCenter += corner;
+                }
+                sphereCenter /= 8.0f;
 
-            return lightProjection * lightView;
+                float radius = 0.0f;
+                for (const Math::Vector3& corner : corners) {
+                    radius = std::max(radius, (corner - sphereCenter).Length());
+                }
+                radius = std::ceil(radius * 16.0f) / 16.0f;
+
+                // Snap the center to whole shadow-map texels so edges do not shimmer as the camera moves.
+                // Depth is snapped too, which keeps the matrix bit-identical (and the static cache valid)
+                // for as long as the camera stays within the same texel.
+                Math::Vector4 lightCenter = lightView * Math::Vector4(sphereCenter.x, sphereCenter.y, sphereCenter.z, 1.0f);
+                float texelSize = 2.0f * radius / resolution;
+                float centerX = std::floor(lightCenter.x / texelSize) * texelSize;
+                float centerY = std::floor(lightCenter.y / texelSize) * texelSize;
+                float centerZ = std::floor(lightCenter.z / texelSize) * texelSize;
+
+                // Extend toward the light so casters outside the slice still reach it
+                float zNear = -centerZ - radius - shadowDistance;
+                float zFar = -centerZ + radius;
+
+                Math::Matrix4 lightProjection = Math::Matrix4::Orthographic(
+                    centerX - radius, centerX + radius,
+                    centerY - radius, centerY + radius,
+                    zNear, zFar
+                );
+
+                cascades[i].lightSpaceMatrix = lightProjection * lightView;
+                cascades[i].splitFar = splitFar;
+                splitNear = splitFar;
+            }
         }
 
     }
-}
\ No newline at end of file
+}
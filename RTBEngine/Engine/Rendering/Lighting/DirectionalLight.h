@@ -8,6 +8,13 @@
 namespace RTBEngine {
     namespace Rendering {
 
+        class Camera;
+
+        struct ShadowCascade {
+            Math::Matrix4 lightSpaceMatrix;
+            float splitFar = 0.0f;      // view-space distance where the cascade ends
+        };
+
         class DirectionalLight : public Light {
         public:
             DirectionalLight();
@@ -17,9 +24,6 @@ namespace RTBEngine {
             void SetDirection(const Math::Vector3& direction) { this->direction = direction.Normalized(); }
             Math::Vector3 GetDirection() const { return direction; }
 
-            void ApplyToShader(Shader* shader) override;
-
-
             void SetCastShadows(bool enabled);
             bool GetCastShadows() const { return castShadows; }
 
@@ -29,15 +33,35 @@ namespace RTBEngine {
             void SetShadowBias(float bias) { shadowBias = bias; }
             float GetShadowBias() const { return shadowBias; }
 
-            Math::Matrix4 GetLightSpaceMatrix(const Math::Vector3& sceneCenter, float sceneRadius) const;
+            // Number of slices the view frustum is split into, 1..MAX_SHADOW_CASCADES
+            void SetShadowCascadeCount(int count);
+            int GetShadowCascadeCount() const { return cascadeCount; }
+
+            // Shadows end this far from the camera (or at its far plane, if closer)
+            void SetShadowDistance(float distance) { shadowDistance = distance; }
+            float GetShadowDistance() const { return shadowDistance; }
+
+            // Blend between logarithmic (1) and uniform (0) cascade splits
+            void SetCascadeSplitLambda(float lambda) { cascadeSplitLambda = lambda; }
+            float GetCascadeSplitLambda() const { return cascadeSplitLambda; }
+
+            // Splits the camera frustum and fits one texel-snapped orthographic projection per cascade
+            void UpdateCascades(const Camera& camera);
+            const ShadowCascade* GetCascades() const { return cascades; }
 
             ShadowMap* GetShadowMap() { return shadowMap.get(); }
 
         private:
+            void CreateShadowMap(int resolution);
+
             Math::Vector3 direction;
 
             bool castShadows;
             float shadowBias;
+            int cascadeCount;
+            float shadowDistance;
+            float cascadeSplitLambda;
+            ShadowCascade cascades[MAX_SHADOW_CASCADES];
             std::unique_ptr<ShadowMap> shadowMap;
 
         };
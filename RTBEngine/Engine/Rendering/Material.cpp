@@ -1,12 +1,23 @@
 #include "Material.h"
+#include <atomic>
+
 namespace RTBEngine {
     namespace Rendering {
 
+        static std::atomic<uint32_t> nextMaterialSortId{ 1 };
+
+        static constexpr UniformId COLOR_UNIFORM("uColor");
+        static constexpr UniformId DIFFUSE_COLOR_UNIFORM("uDiffuseColor");
+        static constexpr UniformId SHININESS_UNIFORM("uShininess");
+        static constexpr UniformId HAS_TEXTURE_UNIFORM("uHasTexture");
+        static constexpr UniformId TEXTURE_UNIFORM("uTexture");
+
 		Material::Material(Shader* shader) :
             shader(shader), texture(nullptr),
             color(Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f)),
             diffuseColor(Math::Vector3(1.0f, 1.0f, 1.0f)),
-            shininess(32.0f)
+            shininess(32.0f),
+            sortId(nextMaterialSortId.fetch_add(1))
         {
 
         }
@@ -20,19 +31,26 @@ namespace RTBEngine {
         {
             if (shader) {
                 shader->Bind();
-                shader->SetVector4("uColor", color);
-                shader->SetVector3("uDiffuseColor", diffuseColor);
-                shader->SetFloat("uShininess", shininess);
-                shader->SetBool("uHasTexture", texture != nullptr);
-                if (texture) {
-                    shader->SetInt("uTexture", 0);
-                }
+                ApplyProperties();
             }
             if (texture) {
                 texture->Bind(0);
             }
         }
 
+        void Material::ApplyProperties()
+        {
+            if (!shader) return;
+
+            shader->SetVector4(COLOR_UNIFORM, color);
+            shader->SetVector3(DIFFUSE_COLOR_UNIFORM, diffuseColor);
+            shader->SetFloat(SHININESS_UNIFORM, shininess);
+            shader->SetBool(HAS_TEXTURE_UNIFORM, texture != nullptr);
+            if (texture) {
+                shader->SetInt(TEXTURE_UNIFORM, 0);
+            }
+        }
+
         void Material::Unbind()
         {
             if (texture) {
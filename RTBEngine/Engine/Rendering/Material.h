@@ -2,6 +2,7 @@
 #include "Shader.h"
 #include "Texture.h"
 #include "../Math/Math.h"
+#include <cstdint>
 
 namespace RTBEngine {
     namespace Rendering {
@@ -17,6 +18,9 @@ namespace RTBEngine {
             void Bind();
             void Unbind();
 
+            // Uploads color/shininess/texture flags to the shader; the shader must already be bound
+            void ApplyProperties();
+
             void SetShader(Shader* shader);
             void SetTexture(Texture* texture);
             void SetColor(const Math::Vector4& color);
@@ -29,12 +33,17 @@ namespace RTBEngine {
             float GetShininess() const { return shininess; }
             const Math::Vector3& GetDiffuseColor() const { return diffuseColor; }
 
+            // Small id for render queue sort keys, one per Material object. Renderers that look the same
+            // share one object (ResourceManager::GetSharedMaterial), so they share the id as well.
+            uint32_t GetSortId() const { return sortId; }
+
         private:
             Shader* shader;
             Texture* texture;
             Math::Vector4 color;
             Math::Vector3 diffuseColor;
             float shininess;
+            uint32_t sortId;
         };
 
     }
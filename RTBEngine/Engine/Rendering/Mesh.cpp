@@ -1,64 +1,137 @@
 #include "Mesh.h"
+#include "GraphicsContext.h"
+#include "InstanceBuffer.h"
+#include "GLStateCache.h"
 #include <limits>
+#include <atomic>
 
-RTBEngine::Rendering::Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-	:VAO(0), VBO(0), EBO(0), vertexCount(static_cast<unsigned int>(vertices.size())), indexCount(static_cast<unsigned int>(indices.size()))
+static std::atomic<uint32_t> nextMeshSortId{ 1 };
+
+RTBEngine::Rendering::Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+	VertexLayout layout, const std::vector<MeshLodLevel>& lodLevels)
+	:vertexCount(static_cast<unsigned int>(vertices.size())), indexCount(static_cast<unsigned int>(indices.size())),
+	vertexLayout(layout), sortId(nextMeshSortId.fetch_add(1))
 {
-	SetupMesh(vertices, indices);
+	// Bounds first: they define the position quantization range
 	CalculateAABB(vertices);
+	quantization = VertexPacker::ComputeQuantization(GetBounds());
+
+	MeshLod fullDetail;
+	fullDetail.indexCount = indexCount;
+	lods.push_back(fullDetail);
+	uint32_t nextIndex = indexCount;
+	for (const MeshLodLevel& level : lodLevels) {
+		if (lods.size() >= MAX_LODS) break;
+		MeshLod lod;
+		lod.firstIndex = nextIndex;
+		lod.indexCount = static_cast<uint32_t>(level.indices.size());
+		lod.screenSize = level.screenSize;
+		lods.push_back(lod);
+		nextIndex += lod.indexCount;
+	}
+
+	if (GraphicsContext::IsAvailable()) {
+		SetupMesh(vertices, indices, lodLevels);
+	}
+	else {
+		cpuVertices = vertices;
+		cpuIndices = indices;
+	}
 }
 
 RTBEngine::Rendering::Mesh::~Mesh()
 {
+	GeometryArena::GetInstance().Free(geometry);
 }
 
-void RTBEngine::Rendering::Mesh::Draw() const
+void RTBEngine::Rendering::Mesh::Draw(uint32_t lod) const
 {
-	glBindVertexArray(VAO);
-	glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
+	if (!geometry.valid) return;
 
-}
+	const MeshLod& level = GetLod(lod);
 
-void RTBEngine::Rendering::Mesh::SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-{
-	//Create buffers/arrays
-	glGenVertexArrays(1, &VAO); //Vertex Array Object 
-	glGenBuffers(1, &VBO); //Vertex Buffer Object
-	glGenBuffers(1, &EBO); //Element Buffer Object
+	// Every mesh of this layout shares the arena VAO, so consecutive meshes skip the bind
+	GLStateCache::GetInstance().BindVertexArray(GeometryArena::GetInstance().GetVertexArray(vertexLayout));
+	glDrawElementsBaseVertex(GL_TRIANGLES, level.indexCount, geometry.indexType,
+		reinterpret_cast<void*>(GetLodIndexOffset(level)), geometry.baseVertex);
 
-	//Activate VAO
-	glBindVertexArray(VAO);
+}
 
-	// Load data into vertex buffers
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+void RTBEngine::Rendering::Mesh::DrawInstanced(GLintptr instanceOffset, GLsizei instanceCount, uint32_t lod) const
+{
+	if (!geometry.valid || instanceCount <= 0) return;
 
-	// Load data into element buffer
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+	const MeshLod& level = GetLod(lod);
 
-	// VAO save info Position (location 0) -> glVertexAttribPointer for float
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-	glEnableVertexAttribArray(0);
+	GLStateCache::GetInstance().BindVertexArray(GeometryArena::GetInstance().GetVertexArray(vertexLayout));
+	glBindVertexBuffer(InstanceBuffer::BINDING_INDEX, InstanceBuffer::GetInstance().GetBufferID(),
+		instanceOffset, sizeof(InstanceData));
+	glDrawElementsInstancedBaseVertex(GL_TRIANGLES, level.indexCount, geometry.indexType,
+		reinterpret_cast<void*>(GetLodIndexOffset(level)), instanceCount, geometry.baseVertex);
+}
 
-	// VAO save info Normal (location 1)
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-	glEnableVertexAttribArray(1);
+GLsizeiptr RTBEngine::Rendering::Mesh::GetLodIndexOffset(const MeshLod& lod) const
+{
+	return static_cast<GLsizeiptr>(geometry.indexOffset + lod.firstIndex * geometry.GetIndexSize());
+}
 
-	// VAO save info TexCoords (location 2)
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
-	glEnableVertexAttribArray(2);
+void RTBEngine::Rendering::Mesh::SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+	const std::vector<MeshLodLevel>& lodLevels)
+{
+	// All levels go into one index range behind the full-detail indices
+	std::vector<unsigned int> allIndices = indices;
+	for (size_t i = 1; i < lods.size(); i++) {
+		const std::vector<unsigned int>& levelIndices = lodLevels[i - 1].indices;
+		allIndices.insert(allIndices.end(), levelIndices.begin(), levelIndices.end());
+	}
 
-	// VAO save info BoneIndices (location 3) -> glVertexAttribIPointer for integers
-	glVertexAttribIPointer(3, 4, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, boneIndices));
-	glEnableVertexAttribArray(3);
+	// Packed vertices and indices are sub-allocated from the shared arena instead of per-mesh buffers
+	std::vector<uint8_t> packed = VertexPacker::Pack(vertices, vertexLayout, quantization);
+	GeometryArena::GetInstance().Allocate(vertexLayout, packed.data(), vertexCount, allIndices, geometry);
+}
 
-	// VAO save info BoneWeights (location 4)
-	glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, boneWeights));
-	glEnableVertexAttribArray(4);
+void RTBEngine::Rendering::Mesh::BuildOccluderGeometry()
+{
+	if (occluderGeometryBuilt) return;
+	occluderGeometryBuilt = true;
+	if (vertexLayout == VertexLayout::Skinned) return;
+
+	std::vector<Math::Vector3> positions;
+	std::vector<unsigned int> indices;
+	if (geometry.valid) {
+		std::vector<uint8_t> packed;
+		const MeshLod& coarsest = lods.back();
+		if (!GeometryArena::GetInstance().Read(geometry, coarsest.firstIndex, coarsest.indexCount, packed, indices)) return;
+
+		const StaticVertex* packedVertices = reinterpret_cast<const StaticVertex*>(packed.data());
+		positions.resize(vertexCount);
+		for (unsigned int i = 0; i < vertexCount; i++) {
+			positions[i] = VertexPacker::DecodePosition(packedVertices[i].position, quantization);
+		}
+	}
+	else {
+		// Headless meshes only keep the full-detail level
+		positions.reserve(cpuVertices.size());
+		for (const Vertex& vertex : cpuVertices) {
+			positions.push_back(vertex.position);
+		}
+		indices = cpuIndices;
+	}
 
-	glBindVertexArray(0);
+	std::vector<uint32_t> remap(positions.size(), std::numeric_limits<uint32_t>::max());
+	occluderIndices.reserve(indices.size());
+	for (unsigned int index : indices) {
+		if (index >= positions.size()) {
+			occluderPositions.clear();
+			occluderIndices.clear();
+			return;
+		}
+		if (remap[index] == std::numeric_limits<uint32_t>::max()) {
+			remap[index] = static_cast<uint32_t>(occluderPositions.size());
+			occluderPositions.push_back(positions[index]);
+		}
+		occluderIndices.push_back(remap[index]);
+	}
 }
 
 void RTBEngine::Rendering::Mesh::CalculateAABB(const std::vector<Vertex>& vertices)
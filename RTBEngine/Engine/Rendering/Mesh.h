@@ -1,47 +1,105 @@
 #pragma once
 #include <GL/glew.h>
 #include <vector>
+#include <cstdint>
 #include "Vertex.h"
+#include "VertexFormat.h"
+#include "GeometryArena.h"
+#include "MeshSimplifier.h"
 #include "../Math/Vectors/Vector3.h"
+#include "../Math/Geometry/AABB.h"
 
 
 // Guide from: https://learnopengl.com/Model-Loading/Mesh
 namespace RTBEngine {
     namespace Rendering {
 
+        // Index range of one detail level inside the mesh's arena allocation
+        struct MeshLod {
+            uint32_t firstIndex = 0;    // relative to the mesh's first index
+            uint32_t indexCount = 0;
+            float screenSize = 0.0f;    // see MeshLodLevel; unused for LOD 0
+        };
+
         class Mesh {
         public:
-            Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+            static constexpr uint32_t MAX_LODS = 4;
+
+            // Vertices are packed into layout on upload; skinned meshes need VertexLayout::Skinned.
+            // lodLevels (coarsest last) share the vertices and are appended to the index range.
+            Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                VertexLayout layout = VertexLayout::Static, const std::vector<MeshLodLevel>& lodLevels = {});
             ~Mesh();
 
             Mesh(const Mesh&) = delete;
             Mesh& operator=(const Mesh&) = delete;
 
-            void Draw() const;
+            void Draw(uint32_t lod = 0) const;
+            // Draws instanceCount copies, reading InstanceData from InstanceBuffer at the given byte offset
+            void DrawInstanced(GLintptr instanceOffset, GLsizei instanceCount, uint32_t lod = 0) const;
 
             unsigned int GetVertexCount() const { return vertexCount; }
+            // Full-detail level only
             unsigned int GetIndexCount() const { return indexCount; }
 
+            uint32_t GetLodCount() const { return static_cast<uint32_t>(lods.size()); }
+            // Out-of-range levels clamp to the coarsest one
+            const MeshLod& GetLod(uint32_t lod) const { return lods[lod < lods.size() ? lod : lods.size() - 1]; }
+
+            VertexLayout GetVertexLayout() const { return vertexLayout; }
+            // Placement in the shared GeometryArena (16-bit indices when the mesh allows it)
+            const GeometryAllocation& GetGeometry() const { return geometry; }
+            // Dequantization of the packed positions, uploaded per draw by RenderQueue
+            const VertexQuantization& GetQuantization() const { return quantization; }
+            // Bytes of vertex data on the GPU
+            size_t GetVertexBufferSize() const { return static_cast<size_t>(vertexCount) * VertexPacker::GetStride(vertexLayout); }
+
+            // CPU copies, only kept when there is no GL context (headless mode)
+            const std::vector<Vertex>& GetVertices() const { return cpuVertices; }
+            const std::vector<unsigned int>& GetIndices() const { return cpuIndices; }
+            bool IsUploaded() const { return geometry.valid; }
+
+            // Coarsest level with only the vertex positions it uses, for OcclusionCuller. Built on first
+            // use from the GPU copy (or the headless CPU copy); skinned meshes have none.
+            void BuildOccluderGeometry();
+            const std::vector<Math::Vector3>& GetOccluderPositions() const { return occluderPositions; }
+            const std::vector<uint32_t>& GetOccluderIndices() const { return occluderIndices; }
+
             // AABB (Axis-Aligned Bounding Box)
             Math::Vector3 GetAABBMin() const { return aabbMin; }
             Math::Vector3 GetAABBMax() const { return aabbMax; }
             Math::Vector3 GetAABBSize() const { return aabbMax - aabbMin; }
             Math::Vector3 GetAABBCenter() const { return (aabbMin + aabbMax) * 0.5f; }
+            Math::AABB GetBounds() const { return Math::AABB(aabbMin, aabbMax); }
 
             // Material index (from model file)
             void SetMaterialIndex(int index) { materialIndex = index; }
             int GetMaterialIndex() const { return materialIndex; }
 
+            // Small unique id for render queue sort keys
+            uint32_t GetSortId() const { return sortId; }
+
         private:
-            void SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+            void SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                const std::vector<MeshLodLevel>& lodLevels);
+            GLsizeiptr GetLodIndexOffset(const MeshLod& lod) const;
             void CalculateAABB(const std::vector<Vertex>& vertices);
 
-            GLuint VAO;
-            GLuint VBO;
-            GLuint EBO;
+            GeometryAllocation geometry;
 
             unsigned int vertexCount;
             unsigned int indexCount;
+            std::vector<MeshLod> lods;
+
+            VertexLayout vertexLayout;
+            VertexQuantization quantization;
+
+            std::vector<Vertex> cpuVertices;
+            std::vector<unsigned int> cpuIndices;
+
+            std::vector<Math::Vector3> occluderPositions;
+            std::vector<uint32_t> occluderIndices;
+            bool occluderGeometryBuilt = false;
 
             // Bounding box
             Math::Vector3 aabbMin;
@@ -49,6 +107,8 @@ namespace RTBEngine {
 
             // Material index (-1 = no material)
             int materialIndex = -1;
+
+            uint32_t sortId;
         };
 
     }
@@ -0,0 +1,356 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static constexpr unsigned int NO_VERTEX = std::numeric_limits<unsigned int>::max();
+
+        // Hash and equality over the raw bytes of vertices[i], so the map only stores indices
+        struct VertexBytesHash {
+            const std::vector<Vertex>* vertices;
+            size_t operator()(unsigned int index) const {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&(*vertices)[index]);
+                uint64_t hash = 14695981039346656037ull;
+                for (size_t i = 0; i < sizeof(Vertex); ++i) {
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+                }
+                return static_cast<size_t>(hash);
+            }
+        };
+
+        struct VertexBytesEqual {
+            const std::vector<Vertex>* vertices;
+            bool operator()(unsigned int a, unsigned int b) const {
+                return std::memcmp(&(*vertices)[a], &(*vertices)[b], sizeof(Vertex)) == 0;
+            }
+        };
+
+        // Concatenates the clusters [splits[c], splits[c + 1]) ordered by how far they face out of the mesh
+        static std::vector<unsigned int> SortClustersOutsideIn(const std::vector<unsigned int>& indices,
+            const std::vector<Vertex>& vertices, const std::vector<uint32_t>& splits)
+        {
+            size_t clusterCount = splits.size() - 1;
+
+            // Area-weighted centroid of the mesh, then of each cluster with its average normal
+            Math::Vector3 meshCentroid(0.0f, 0.0f, 0.0f);
+            float meshArea = 0.0f;
+            std::vector<Math::Vector3> clusterCentroids(clusterCount, Math::Vector3(0.0f, 0.0f, 0.0f));
+            std::vector<Math::Vector3> clusterNormals(clusterCount, Math::Vector3(0.0f, 0.0f, 0.0f));
+            std::vector<float> clusterAreas(clusterCount, 0.0f);
+
+            for (size_t c = 0; c < clusterCount; ++c) {
+                for (uint32_t t = splits[c]; t < splits[c + 1]; ++t) {
+                    const Math::Vector3& p0 = vertices[indices[t * 3 + 0]].position;
+                    const Math::Vector3& p1 = vertices[indices[t * 3 + 1]].position;
+                    const Math::Vector3& p2 = vertices[indices[t * 3 + 2]].position;
+                    Math::Vector3 normal = (p1 - p0).Cross(p2 - p0);
+                    float area = normal.Length();
+                    Math::Vector3 centroid = (p0 + p1 + p2) * (area / 3.0f);
+
+                    clusterCentroids[c] += centroid;
+                    clusterNormals[c] += normal;
+                    clusterAreas[c] += area;
+                    meshCentroid += centroid;
+                    meshArea += area;
+                }
+            }
+            if (meshArea <= 0.0f) return indices;
+            meshCentroid /= meshArea;
+
+            // Clusters facing outward from the centre are likely occluders: draw them first
+            std::vector<float> sortKeys(clusterCount, 0.0f);
+            for (size_t c = 0; c < clusterCount; ++c) {
+                if (clusterAreas[c] <= 0.0f) continue;
+                Math::Vector3 centroid = clusterCentroids[c] / clusterAreas[c];
+                float normalLength = clusterNormals[c].Length();
+                if (normalLength <= 0.0f) continue;
+                sortKeys[c] = (centroid - meshCentroid).Dot(clusterNormals[c] / normalLength);
+            }
+
+            std::vector<uint32_t> order(clusterCount);
+            for (size_t c = 0; c < clusterCount; ++c) {
+                order[c] = static_cast<uint32_t>(c);
+            }
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return sortKeys[a] > sortKeys[b];
+            });
+
+            std::vector<unsigned int> reordered;
+            reordered.reserve(indices.size());
+            for (uint32_t c : order) {
+                reordered.insert(reordered.end(), indices.begin() + splits[c] * 3, indices.begin() + splits[c + 1] * 3);
+            }
+            return reordered;
+        }
+
+        MeshOptimizeStats MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+            const MeshOptimizeOptions& options)
+        {
+            MeshOptimizeStats stats;
+            stats.verticesBefore = static_cast<uint32_t>(vertices.size());
+            stats.acmrBefore = ComputeACMR(indices, vertices.size(), options.cacheSize);
+
+            // Only plain triangle lists are reordered
+            if (options.enabled && !indices.empty() && indices.size() % 3 == 0) {
+                if (options.weldVertices) {
+                    WeldVertices(vertices, indices);
+                }
+                if (options.optimizeVertexCache) {
+                    OptimizeVertexCache(indices, vertices.size(), options.cacheSize);
+                }
+                if (options.optimizeOverdraw) {
+                    OptimizeOverdraw(indices, vertices, options.cacheSize, options.overdrawThreshold);
+                }
+                if (options.optimizeVertexFetch) {
+                    OptimizeVertexFetch(vertices, indices);
+                }
+            }
+
+            stats.verticesAfter = static_cast<uint32_t>(vertices.size());
+            stats.acmrAfter = ComputeACMR(indices, vertices.size(), options.cacheSize);
+            return stats;
+        }
+
+        void MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+        {
+            std::unordered_map<unsigned int, unsigned int, VertexBytesHash, VertexBytesEqual> unique(
+                vertices.size(), VertexBytesHash{ &vertices }, VertexBytesEqual{ &vertices });
+
+            std::vector<unsigned int> remap(vertices.size());
+            std::vector<Vertex> welded;
+            welded.reserve(vertices.size());
+
+            for (unsigned int i = 0; i < vertices.size(); ++i) {
+                auto result = unique.emplace(i, static_cast<unsigned int>(welded.size()));
+                if (result.second) {
+                    welded.push_back(vertices[i]);
+                }
+                remap[i] = result.first->second;
+            }
+
+            for (unsigned int& index : indices) {
+                index = remap[index];
+            }
+            vertices = std::move(welded);
+        }
+
+        void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount, uint32_t cacheSize)
+        {
+            // Tipsify: fan around a vertex, then continue from the emitted vertex that is still in the
+            // cache and has the fewest triangles left, falling back to recently used (dead-end) vertices.
+            size_t triangleCount = indices.size() / 3;
+            if (triangleCount == 0) return;
+
+            // Vertex -> triangle adjacency, stored as one array with per-vertex offsets
+            std::vector<uint32_t> liveCount(vertexCount, 0);
+            for (unsigned int index : indices) {
+                liveCount[index]++;
+            }
+            std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveCount[v];
+            }
+            std::vector<uint32_t> adjacency(indices.size());
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i) {
+                adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+
+            std::vector<uint32_t> cacheTime(vertexCount, 0);
+            std::vector<bool> emitted(triangleCount, false);
+            std::vector<unsigned int> deadEnds;
+            std::vector<unsigned int> candidates;
+            std::vector<unsigned int> output;
+            output.reserve(indices.size());
+
+            uint32_t time = cacheSize + 1;
+            size_t cursor = 0;
+
+            auto skipDeadEnd = [&]() -> unsigned int {
+                while (!deadEnds.empty()) {
+                    unsigned int vertex = deadEnds.back();
+                    deadEnds.pop_back();
+                    if (liveCount[vertex] > 0) return vertex;
+                }
+                while (cursor < vertexCount) {
+                    if (liveCount[cursor] > 0) return static_cast<unsigned int>(cursor);
+                    ++cursor;
+                }
+                return NO_VERTEX;
+            };
+
+            unsigned int fanning = skipDeadEnd();
+            while (fanning != NO_VERTEX) {
+                candidates.clear();
+
+                for (uint32_t a = adjacencyOffsets[fanning]; a < adjacencyOffsets[fanning + 1]; ++a) {
+                    uint32_t triangle = adjacency[a];
+                    if (emitted[triangle]) continue;
+
+                    for (int k = 0; k < 3; ++k) {
+                        unsigned int vertex = indices[triangle * 3 + k];
+                        output.push_back(vertex);
+                        deadEnds.push_back(vertex);
+                        candidates.push_back(vertex);
+                        liveCount[vertex]--;
+                        if (time - cacheTime[vertex] > cacheSize) {
+                            cacheTime[vertex] = time++;
+                        }
+                    }
+                    emitted[triangle] = true;
+                }
+
+                // Prefer the candidate that entered the cache earliest but will still be there after
+                // fanning around it; vertices that would fall out score 0
+                unsigned int next = NO_VERTEX;
+                int64_t bestPriority = -1;
+                for (unsigned int vertex : candidates) {
+                    if (liveCount[vertex] == 0) continue;
+
+                    int64_t priority = 0;
+                    uint32_t age = time - cacheTime[vertex];
+                    if (age + 2 * liveCount[vertex] <= cacheSize) {
+                        priority = age;
+                    }
+                    if (priority > bestPriority) {
+                        bestPriority = priority;
+                        next = vertex;
+                    }
+                }
+
+                fanning = next != NO_VERTEX ? next : skipDeadEnd();
+            }
+
+            indices = std::move(output);
+        }
+
+        void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+            uint32_t cacheSize, float threshold)
+        {
+            size_t triangleCount = indices.size() / 3;
+            if (triangleCount < 2) return;
+
+            float acmrBefore = ComputeACMR(indices, vertices.size(), cacheSize);
+
+            // Hard boundaries: triangles whose three vertices all miss the cache start a new cluster
+            std::vector<uint32_t> clusterStarts;
+            {
+                std::vector<uint32_t> cacheTime(vertices.size(), 0);
+                uint32_t time = cacheSize + 1;
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    int misses = 0;
+                    for (int k = 0; k < 3; ++k) {
+                        unsigned int vertex = indices[t * 3 + k];
+                        if (time - cacheTime[vertex] > cacheSize) {
+                            cacheTime[vertex] = time++;
+                            misses++;
+                        }
+                    }
+                    if (t == 0 || misses == 3) {
+                        clusterStarts.push_back(static_cast<uint32_t>(t));
+                    }
+                }
+                clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+            }
+
+            // Soft boundaries: split a hard cluster wherever the piece so far, simulated from a cold
+            // cache, is already within threshold of the cluster's own ACMR
+            std::vector<uint32_t> splits;
+            {
+                std::vector<uint32_t> cacheTime(vertices.size(), 0);
+                uint32_t time = cacheSize + 1;
+                for (size_t c = 0; c + 1 < clusterStarts.size(); ++c) {
+                    uint32_t begin = clusterStarts[c];
+                    uint32_t end = clusterStarts[c + 1];
+
+                    time += cacheSize + 1;
+                    uint32_t clusterMisses = 0;
+                    for (uint32_t t = begin; t < end; ++t) {
+                        for (int k = 0; k < 3; ++k) {
+                            unsigned int vertex = indices[t * 3 + k];
+                            if (time - cacheTime[vertex] > cacheSize) {
+                                cacheTime[vertex] = time++;
+                                clusterMisses++;
+                            }
+                        }
+                    }
+                    float limit = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+                    splits.push_back(begin);
+                    time += cacheSize + 1;
+                    uint32_t pieceStart = begin;
+                    uint32_t pieceMisses = 0;
+                    for (uint32_t t = begin; t < end; ++t) {
+                        for (int k = 0; k < 3; ++k) {
+                            unsigned int vertex = indices[t * 3 + k];
+                            if (time - cacheTime[vertex] > cacheSize) {
+                                cacheTime[vertex] = time++;
+                                pieceMisses++;
+                            }
+                        }
+                        uint32_t pieceTriangles = t + 1 - pieceStart;
+                        if (t + 1 < end && static_cast<float>(pieceMisses) / pieceTriangles <= limit) {
+                            splits.push_back(t + 1);
+                            pieceStart = t + 1;
+                            pieceMisses = 0;
+                            time += cacheSize + 1;
+                        }
+                    }
+                }
+                splits.push_back(static_cast<uint32_t>(triangleCount));
+            }
+
+            // Soft splits give the best overdraw order; if they cost too much cache reuse, fall back to
+            // the hard clusters, whose boundaries were full misses anyway
+            for (const std::vector<uint32_t>* candidate : { &splits, &clusterStarts }) {
+                if (candidate->size() < 3) continue;
+
+                std::vector<unsigned int> reordered = SortClustersOutsideIn(indices, vertices, *candidate);
+                if (ComputeACMR(reordered, vertices.size(), cacheSize) <= acmrBefore * threshold) {
+                    indices = std::move(reordered);
+                    return;
+                }
+            }
+        }
+
+        void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+        {
+            // Vertices in the order the index buffer first touches them; unreferenced ones are dropped
+            std::vector<unsigned int> remap(vertices.size(), NO_VERTEX);
+            std::vector<Vertex> reordered;
+            reordered.reserve(vertices.size());
+
+            for (unsigned int& index : indices) {
+                if (remap[index] == NO_VERTEX) {
+                    remap[index] = static_cast<unsigned int>(reordered.size());
+                    reordered.push_back(vertices[index]);
+                }
+                index = remap[index];
+            }
+            vertices = std::move(reordered);
+        }
+
+        float MeshOptimizer::ComputeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, uint32_t cacheSize)
+        {
+            size_t triangleCount = indices.size() / 3;
+            if (triangleCount == 0) return 0.0f;
+
+            // A vertex is in the FIFO while fewer than cacheSize misses have happened since it entered
+            std::vector<uint32_t> cacheTime(vertexCount, 0);
+            uint32_t time = cacheSize + 1;
+            uint32_t misses = 0;
+            for (unsigned int index : indices) {
+                if (time - cacheTime[index] > cacheSize) {
+                    cacheTime[index] = time++;
+                    misses++;
+                }
+            }
+            return static_cast<float>(misses) / static_cast<float>(triangleCount);
+        }
+
+    }
+}
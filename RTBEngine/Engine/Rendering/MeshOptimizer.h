@@ -0,0 +1,64 @@
+#pragma once
+#include "Vertex.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Import-time optimization settings, chosen per asset
+        struct MeshOptimizeOptions {
+            bool enabled = true;
+            bool weldVertices = true;       // merge bit-identical vertices
+            bool optimizeVertexCache = true;// Tipsify triangle order
+            bool optimizeOverdraw = true;   // reorder cache-friendly clusters outside-in
+            bool optimizeVertexFetch = true;// vertices in first-use order
+            uint32_t cacheSize = 16;        // simulated post-transform FIFO size
+            // Overdraw ordering may raise the ACMR by at most this factor
+            float overdrawThreshold = 1.05f;
+
+            // Simplified levels generated below the full mesh (see MeshSimplifier)
+            uint32_t lodLevels = 3;
+            float lodReduction = 0.5f;      // triangles kept per level, relative to the previous one
+            float lodMaxError = 0.05f;      // largest collapse error, relative to the mesh extent
+            float lodScreenSize = 0.25f;    // screen-height fraction below which LOD 1 is drawn; halves per level
+
+            bool operator==(const MeshOptimizeOptions& other) const {
+                return enabled == other.enabled && weldVertices == other.weldVertices
+                    && optimizeVertexCache == other.optimizeVertexCache && optimizeOverdraw == other.optimizeOverdraw
+                    && optimizeVertexFetch == other.optimizeVertexFetch && cacheSize == other.cacheSize
+                    && overdrawThreshold == other.overdrawThreshold && lodLevels == other.lodLevels
+                    && lodReduction == other.lodReduction && lodMaxError == other.lodMaxError
+                    && lodScreenSize == other.lodScreenSize;
+            }
+            bool operator!=(const MeshOptimizeOptions& other) const { return !(*this == other); }
+        };
+
+        struct MeshOptimizeStats {
+            uint32_t verticesBefore = 0;
+            uint32_t verticesAfter = 0;
+            float acmrBefore = 0.0f;
+            float acmrAfter = 0.0f;
+            uint32_t lodCount = 1;          // including the full mesh
+        };
+
+        // Triangle-list optimizations run after import and before upload (Sander et al., "Fast
+        // Triangle Reordering for Vertex Locality and Reduced Overdraw"). Everything here is CPU-only
+        // and deterministic: the same input always gives the same buffers.
+        class MeshOptimizer {
+        public:
+            static MeshOptimizeStats Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                const MeshOptimizeOptions& options);
+
+            static void WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+            static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount, uint32_t cacheSize);
+            static void OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                uint32_t cacheSize, float threshold);
+            static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+            // Average cache miss ratio: transformed vertices per triangle with a FIFO cache
+            static float ComputeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, uint32_t cacheSize);
+        };
+
+    }
+}
@@ -0,0 +1,360 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Collapses between vertices whose bone weights differ by more than this (sum of absolute
+        // differences, 0..2) would visibly move skin from one bone to another
+        static constexpr float MAX_SKIN_DISTANCE = 0.5f;
+
+        // A triangle may turn by at most ~75 degrees in a collapse; more usually means a fold
+        static constexpr float MIN_NORMAL_COSINE = 0.25f;
+
+        // Levels that keep more than this share of the previous level's triangles are not worth a draw
+        static constexpr float MIN_LOD_SHRINK = 0.9f;
+
+        // Symmetric 4x4 error quadric of a set of planes; Evaluate is the sum of squared distances
+        struct Quadric {
+            double a2 = 0, ab = 0, ac = 0, ad = 0;
+            double b2 = 0, bc = 0, bd = 0;
+            double c2 = 0, cd = 0;
+            double d2 = 0;
+
+            void AddPlane(double a, double b, double c, double d, double weight) {
+                a2 += a * a * weight; ab += a * b * weight; ac += a * c * weight; ad += a * d * weight;
+                b2 += b * b * weight; bc += b * c * weight; bd += b * d * weight;
+                c2 += c * c * weight; cd += c * d * weight;
+                d2 += d * d * weight;
+            }
+
+            void Add(const Quadric& other) {
+                a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+                b2 += other.b2; bc += other.bc; bd += other.bd;
+                c2 += other.c2; cd += other.cd;
+                d2 += other.d2;
+            }
+
+            double Evaluate(const Math::Vector3& p) const {
+                double x = p.x, y = p.y, z = p.z;
+                double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+                    + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+                    + c2 * z * z + 2.0 * cd * z
+                    + d2;
+                return error > 0.0 ? error : 0.0;
+            }
+        };
+
+        struct Collapse {
+            unsigned int from;
+            unsigned int to;
+            float error;
+        };
+
+        static float SkinDistance(const Vertex& a, const Vertex& b)
+        {
+            float distance = 0.0f;
+            for (int i = 0; i < MAX_BONE_INFLUENCE; ++i) {
+                if (a.boneWeights[i] == 0.0f) continue;
+                float other = 0.0f;
+                for (int j = 0; j < MAX_BONE_INFLUENCE; ++j) {
+                    if (b.boneWeights[j] != 0.0f && b.boneIndices[j] == a.boneIndices[i]) other = b.boneWeights[j];
+                }
+                distance += std::fabs(a.boneWeights[i] - other);
+            }
+            for (int j = 0; j < MAX_BONE_INFLUENCE; ++j) {
+                if (b.boneWeights[j] == 0.0f) continue;
+                bool shared = false;
+                for (int i = 0; i < MAX_BONE_INFLUENCE; ++i) {
+                    if (a.boneWeights[i] != 0.0f && a.boneIndices[i] == b.boneIndices[j]) shared = true;
+                }
+                if (!shared) distance += b.boneWeights[j];
+            }
+            return distance;
+        }
+
+        // Maps every vertex to the lowest-indexed vertex at the same position
+        static std::vector<unsigned int> BuildPositionRemap(const std::vector<Vertex>& vertices)
+        {
+            std::vector<unsigned int> order(vertices.size());
+            for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<unsigned int>(i);
+
+            auto less = [&vertices](unsigned int a, unsigned int b) {
+                const Math::Vector3& pa = vertices[a].position;
+                const Math::Vector3& pb = vertices[b].position;
+                if (pa.x != pb.x) return pa.x < pb.x;
+                if (pa.y != pb.y) return pa.y < pb.y;
+                if (pa.z != pb.z) return pa.z < pb.z;
+                return a < b;
+            };
+            std::sort(order.begin(), order.end(), less);
+
+            std::vector<unsigned int> remap(vertices.size());
+            for (size_t i = 0; i < order.size();) {
+                size_t end = i + 1;
+                const Math::Vector3& p = vertices[order[i]].position;
+                while (end < order.size() && vertices[order[end]].position.x == p.x
+                    && vertices[order[end]].position.y == p.y && vertices[order[end]].position.z == p.z) {
+                    ++end;
+                }
+                for (size_t j = i; j < end; ++j) remap[order[j]] = order[i];
+                i = end;
+            }
+            return remap;
+        }
+
+        // Seam vertices (several vertices at one position), border and non-manifold vertices stay in place
+        static std::vector<char> FindLockedVertices(const std::vector<unsigned int>& indices,
+            const std::vector<unsigned int>& remap)
+        {
+            std::vector<char> locked(remap.size(), 0);
+            for (size_t i = 0; i < remap.size(); ++i) {
+                if (remap[i] != i) {
+                    locked[i] = 1;
+                    locked[remap[i]] = 1;
+                }
+            }
+
+            std::unordered_map<uint64_t, uint32_t> edges;
+            edges.reserve(indices.size());
+            for (size_t i = 0; i < indices.size(); i += 3) {
+                for (int e = 0; e < 3; ++e) {
+                    uint64_t a = remap[indices[i + e]];
+                    uint64_t b = remap[indices[i + (e + 1) % 3]];
+                    edges[(a << 32) | b]++;
+                }
+            }
+
+            for (const auto& edge : edges) {
+                uint64_t a = edge.first >> 32;
+                uint64_t b = edge.first & 0xFFFFFFFFull;
+                auto opposite = edges.find((b << 32) | a);
+                if (edge.second != 1 || opposite == edges.end() || opposite->second != 1) {
+                    locked[a] = 1;
+                    locked[b] = 1;
+                }
+            }
+            return locked;
+        }
+
+        // The endpoints of a collapsed edge may only share the vertices opposite that edge;
+        // anything else would pinch the surface into non-manifold geometry
+        static bool SatisfiesLinkCondition(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& remap,
+            const std::vector<uint32_t>& adjacencyOffsets, const std::vector<uint32_t>& adjacency,
+            unsigned int a, unsigned int b, size_t sharedTriangles)
+        {
+            auto gatherNeighbours = [&](unsigned int vertex, std::vector<unsigned int>& out) {
+                for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; ++i) {
+                    const unsigned int* triangle = &indices[adjacency[i] * 3];
+                    for (int corner = 0; corner < 3; ++corner) {
+                        unsigned int neighbour = remap[triangle[corner]];
+                        if (neighbour != a && neighbour != b) out.push_back(neighbour);
+                    }
+                }
+                std::sort(out.begin(), out.end());
+                out.erase(std::unique(out.begin(), out.end()), out.end());
+            };
+
+            std::vector<unsigned int> neighboursA, neighboursB;
+            gatherNeighbours(a, neighboursA);
+            gatherNeighbours(b, neighboursB);
+
+            size_t shared = 0;
+            for (size_t i = 0, j = 0; i < neighboursA.size() && j < neighboursB.size();) {
+                if (neighboursA[i] < neighboursB[j]) ++i;
+                else if (neighboursB[j] < neighboursA[i]) ++j;
+                else { ++shared; ++i; ++j; }
+            }
+            return shared == sharedTriangles;
+        }
+
+        std::vector<unsigned int> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices,
+            const std::vector<unsigned int>& indices, size_t targetIndexCount, float maxError, float* outError)
+        {
+            std::vector<unsigned int> result = indices;
+            if (outError) *outError = 0.0f;
+            if (vertices.empty() || result.size() <= targetIndexCount) return result;
+
+            Math::Vector3 minimum = vertices[0].position;
+            Math::Vector3 maximum = vertices[0].position;
+            for (const Vertex& vertex : vertices) {
+                minimum = Math::Vector3(std::min(minimum.x, vertex.position.x), std::min(minimum.y, vertex.position.y),
+                    std::min(minimum.z, vertex.position.z));
+                maximum = Math::Vector3(std::max(maximum.x, vertex.position.x), std::max(maximum.y, vertex.position.y),
+                    std::max(maximum.z, vertex.position.z));
+            }
+            Math::Vector3 size = maximum - minimum;
+            float extent = std::max(size.x, std::max(size.y, size.z));
+            if (extent <= 0.0f) return result;
+
+            // Quadric errors are squared distances
+            double errorLimit = static_cast<double>(maxError) * extent * static_cast<double>(maxError) * extent;
+
+            std::vector<unsigned int> remap = BuildPositionRemap(vertices);
+            std::vector<char> locked = FindLockedVertices(result, remap);
+
+            // Area-weighted plane quadrics, accumulated per position
+            std::vector<Quadric> quadrics(vertices.size());
+            for (size_t i = 0; i < result.size(); i += 3) {
+                const Math::Vector3& p0 = vertices[result[i + 0]].position;
+                const Math::Vector3& p1 = vertices[result[i + 1]].position;
+                const Math::Vector3& p2 = vertices[result[i + 2]].position;
+                Math::Vector3 normal = (p1 - p0).Cross(p2 - p0);
+                float length = normal.Length();
+                if (length <= 0.0f) continue;
+
+                double a = normal.x / length, b = normal.y / length, c = normal.z / length;
+                double d = -(a * p0.x + b * p0.y + c * p0.z);
+                double area = length * 0.5;
+                for (int corner = 0; corner < 3; ++corner) {
+                    quadrics[remap[result[i + corner]]].AddPlane(a, b, c, d, area);
+                }
+            }
+
+            std::vector<unsigned int> collapseTo(vertices.size());
+            for (size_t i = 0; i < collapseTo.size(); ++i) collapseTo[i] = static_cast<unsigned int>(i);
+
+            std::vector<uint32_t> adjacencyOffsets;
+            std::vector<uint32_t> adjacency;
+            std::vector<Collapse> collapses;
+            std::vector<char> touched(vertices.size());
+            double worstError = 0.0;
+
+            while (result.size() > targetIndexCount) {
+                // Triangles around every position
+                adjacencyOffsets.assign(vertices.size() + 1, 0);
+                for (unsigned int index : result) adjacencyOffsets[remap[index] + 1]++;
+                for (size_t i = 1; i < adjacencyOffsets.size(); ++i) adjacencyOffsets[i] += adjacencyOffsets[i - 1];
+                adjacency.resize(result.size());
+                std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i) {
+                    adjacency[fill[remap[result[i]]]++] = static_cast<uint32_t>(i / 3);
+                }
+
+                // Every directed edge whose source may move; an unlocked source is the only vertex at its position
+                collapses.clear();
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    for (int e = 0; e < 3; ++e) {
+                        unsigned int from = result[i + e];
+                        unsigned int to = result[i + (e + 1) % 3];
+                        for (int direction = 0; direction < 2; ++direction) {
+                            if (!locked[from] && remap[from] != remap[to]
+                                && SkinDistance(vertices[from], vertices[to]) <= MAX_SKIN_DISTANCE) {
+                                // The merged vertex carries the planes of both ends
+                                Quadric merged = quadrics[from];
+                                merged.Add(quadrics[remap[to]]);
+                                double error = merged.Evaluate(vertices[to].position);
+                                if (error <= errorLimit) {
+                                    collapses.push_back({ from, to, static_cast<float>(error) });
+                                }
+                            }
+                            std::swap(from, to);
+                        }
+                    }
+                }
+                if (collapses.empty()) break;
+
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+                    if (a.error != b.error) return a.error < b.error;
+                    if (a.from != b.from) return a.from < b.from;
+                    return a.to < b.to;
+                });
+
+                // Cheapest first; a collapse changes the triangles around its source, so each pass
+                // skips anything touching a vertex already involved to keep the flip tests valid
+                std::fill(touched.begin(), touched.end(), 0);
+                size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+                size_t trianglesRemoved = 0;
+                size_t applied = 0;
+
+                for (const Collapse& collapse : collapses) {
+                    if (trianglesRemoved >= trianglesToRemove) break;
+
+                    unsigned int from = collapse.from;
+                    unsigned int target = remap[collapse.to];
+                    if (touched[from] || touched[target]) continue;
+
+                    const Math::Vector3& newPosition = vertices[collapse.to].position;
+                    bool flips = false;
+                    size_t removed = 0;
+                    for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1] && !flips; ++a) {
+                        const unsigned int* triangle = &result[adjacency[a] * 3];
+                        unsigned int p[3] = { remap[triangle[0]], remap[triangle[1]], remap[triangle[2]] };
+                        if (p[0] == target || p[1] == target || p[2] == target) {
+                            ++removed;
+                            continue;
+                        }
+
+                        Math::Vector3 before[3], after[3];
+                        for (int corner = 0; corner < 3; ++corner) {
+                            before[corner] = vertices[p[corner]].position;
+                            after[corner] = p[corner] == from ? newPosition : before[corner];
+                        }
+                        Math::Vector3 n0 = (before[1] - before[0]).Cross(before[2] - before[0]);
+                        Math::Vector3 n1 = (after[1] - after[0]).Cross(after[2] - after[0]);
+                        flips = n0.Dot(n1) <= MIN_NORMAL_COSINE * n0.Length() * n1.Length();
+                    }
+                    if (flips || !SatisfiesLinkCondition(result, remap, adjacencyOffsets, adjacency, from, target, removed)) continue;
+
+                    collapseTo[from] = collapse.to;
+                    quadrics[target].Add(quadrics[from]);
+                    worstError = std::max(worstError, static_cast<double>(collapse.error));
+
+                    for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; ++a) {
+                        const unsigned int* triangle = &result[adjacency[a] * 3];
+                        for (int corner = 0; corner < 3; ++corner) touched[remap[triangle[corner]]] = 1;
+                    }
+                    trianglesRemoved += removed;
+                    ++applied;
+                }
+                if (applied == 0) break;
+
+                // Rewrite the collapsed vertices and drop the triangles that became degenerate
+                size_t write = 0;
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    unsigned int a = collapseTo[result[i + 0]];
+                    unsigned int b = collapseTo[result[i + 1]];
+                    unsigned int c = collapseTo[result[i + 2]];
+                    if (remap[a] == remap[b] || remap[b] == remap[c] || remap[a] == remap[c]) continue;
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+                result.resize(write);
+            }
+
+            if (outError) *outError = static_cast<float>(std::sqrt(worstError) / extent);
+            return result;
+        }
+
+        std::vector<MeshLodLevel> MeshSimplifier::GenerateLods(const std::vector<Vertex>& vertices,
+            const std::vector<unsigned int>& indices, const MeshOptimizeOptions& options)
+        {
+            std::vector<MeshLodLevel> levels;
+            size_t previousCount = indices.size();
+            float screenSize = options.lodScreenSize;
+
+            for (uint32_t level = 0; level < options.lodLevels; ++level) {
+                size_t target = static_cast<size_t>(previousCount * options.lodReduction) / 3 * 3;
+
+                // Always from the full mesh, so quadrics carry every original plane
+                MeshLodLevel lod;
+                lod.indices = Simplify(vertices, indices, target, options.lodMaxError, &lod.error);
+                if (lod.indices.empty() || lod.indices.size() > previousCount * MIN_LOD_SHRINK) break;
+
+                if (options.optimizeVertexCache) {
+                    MeshOptimizer::OptimizeVertexCache(lod.indices, vertices.size(), options.cacheSize);
+                }
+                lod.screenSize = screenSize;
+                screenSize *= 0.5f;
+
+                previousCount = lod.indices.size();
+                levels.push_back(std::move(lod));
+            }
+            return levels;
+        }
+
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Vertex.h"
+#include "MeshOptimizer.h"
+#include <cstddef>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // One simplified level of a mesh; indices address the full-detail vertex array
+        struct MeshLodLevel {
+            std::vector<unsigned int> indices;
+            float error = 0.0f;         // largest collapse error, relative to the mesh extent
+            float screenSize = 0.0f;    // drawn once the object covers less of the screen height than this
+        };
+
+        // Quadric error metric edge collapse (Garland and Heckbert, "Surface Simplification Using
+        // Quadric Error Metrics"). Vertices only ever collapse onto a neighbouring vertex, so every
+        // vertex that survives keeps its own normal, UV and skin weights and all levels can share one
+        // vertex buffer. Border vertices and vertices on UV or normal seams are never removed, and
+        // collapses between vertices influenced by different bones are rejected.
+        class MeshSimplifier {
+        public:
+            // Reduces indices towards targetIndexCount without exceeding maxError (relative to the mesh extent)
+            static std::vector<unsigned int> Simplify(const std::vector<Vertex>& vertices,
+                const std::vector<unsigned int>& indices, size_t targetIndexCount, float maxError,
+                float* outError = nullptr);
+
+            // Up to options.lodLevels levels below the full mesh; stops early once a level barely shrinks
+            static std::vector<MeshLodLevel> GenerateLods(const std::vector<Vertex>& vertices,
+                const std::vector<unsigned int>& indices, const MeshOptimizeOptions& options);
+        };
+
+    }
+}
@@ -1,4 +1,5 @@
 #include "ModelLoader.h"
+#include "../Core/Logger.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -41,7 +42,7 @@ namespace RTBEngine {
             return to;
         }
 
-        ModelData ModelLoader::LoadModelWithAnimations(const std::string& path)
+        ModelData ModelLoader::LoadModelWithAnimations(const std::string& path, const MeshOptimizeOptions& optimizeOptions)
         {
             ModelData result;
             result.skeleton = std::make_shared<Animation::Skeleton>();
@@ -83,7 +84,29 @@ namespace RTBEngine {
             ExtractMaterials(scene, result);
 
             // Process meshes and extract bones
-            ProcessNode(scene->mRootNode, scene, result.meshes, result.skeleton);
+            ProcessNode(scene->mRootNode, scene, result, optimizeOptions);
+
+            if (optimizeOptions.enabled && !result.optimizeStats.empty()) {
+                // Triangle-weighted ACMR over the whole model
+                float trianglesTotal = 0.0f, acmrBefore = 0.0f, acmrAfter = 0.0f;
+                uint32_t verticesBefore = 0, verticesAfter = 0, lodCount = 0;
+                for (size_t i = 0; i < result.meshes.size(); i++) {
+                    float triangles = static_cast<float>(result.meshes[i]->GetIndexCount() / 3);
+                    const MeshOptimizeStats& stats = result.optimizeStats[i];
+                    trianglesTotal += triangles;
+                    acmrBefore += stats.acmrBefore * triangles;
+                    acmrAfter += stats.acmrAfter * triangles;
+                    verticesBefore += stats.verticesBefore;
+                    verticesAfter += stats.verticesAfter;
+                    lodCount = std::max(lodCount, stats.lodCount);
+                }
+                if (trianglesTotal > 0.0f) {
+                    RTB_INFO("[ModelLoader] " + path + ": ACMR " + std::to_string(acmrBefore / trianglesTotal)
+                        + " -> " + std::to_string(acmrAfter / trianglesTotal) + ", vertices "
+                        + std::to_string(verticesBefore) + " -> " + std::to_string(verticesAfter)
+                        + ", LODs " + std::to_string(lodCount));
+                }
+            }
 
             // Build bone hierarchy from node tree
             BuildBoneHierarchy(scene->mRootNode, result.skeleton, -1);
@@ -110,27 +133,30 @@ namespace RTBEngine {
             return result;
         }
 
-        std::vector<Mesh*> ModelLoader::LoadModel(const std::string& path)
+        std::vector<Mesh*> ModelLoader::LoadModel(const std::string& path, const MeshOptimizeOptions& optimizeOptions)
         {
-            ModelData data = LoadModelWithAnimations(path);
+            ModelData data = LoadModelWithAnimations(path, optimizeOptions);
             return data.meshes;
         }
 
-        void ModelLoader::ProcessNode(const aiNode* node, const aiScene* scene,
-            std::vector<Mesh*>& meshes, std::shared_ptr<Animation::Skeleton>& skeleton)
+        void ModelLoader::ProcessNode(const aiNode* node, const aiScene* scene, ModelData& outData,
+            const MeshOptimizeOptions& optimizeOptions)
         {
             for (unsigned int i = 0; i < node->mNumMeshes; i++) {
                 aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-                meshes.push_back(ProcessMesh(mesh, scene, skeleton));
+                MeshOptimizeStats stats;
+                outData.meshes.push_back(ProcessMesh(mesh, scene, outData.skeleton, optimizeOptions, stats));
+                outData.optimizeStats.push_back(stats);
             }
 
             for (unsigned int i = 0; i < node->mNumChildren; i++) {
-                ProcessNode(node->mChildren[i], scene, meshes, skeleton);
+                ProcessNode(node->mChildren[i], scene, outData, optimizeOptions);
             }
         }
 
         Mesh* ModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene,
-            std::shared_ptr<Animation::Skeleton>& skeleton)
+            std::shared_ptr<Animation::Skeleton>& skeleton, const MeshOptimizeOptions& optimizeOptions,
+            MeshOptimizeStats& outStats)
         {
             std::vector<Vertex> vertices;
             std::vector<unsigned int> indices;
@@ -193,7 +219,24 @@ namespace RTBEngine {
                 }
             }
 
-            Mesh* resultMesh = new Mesh(vertices, indices);
+            // Weld and reorder after bone extraction, which addresses vertices by their Assimp index
+            outStats = MeshOptimizer::Optimize(vertices, indices, optimizeOptions);
+
+            // Only meshes with bones pay for the bone attributes
+            VertexLayout layout = mesh->HasBones() ? VertexLayout::Skinned : VertexLayout::Static;
+            if (layout == VertexLayout::Skinned && skeleton->GetBoneCount() > VertexPacker::MAX_PACKED_BONES) {
+                RTB_WARN("Mesh " + std::string(mesh->mName.C_Str()) + " references more than "
+                    + std::to_string(VertexPacker::MAX_PACKED_BONES) + " bones; influences beyond that are dropped");
+            }
+
+            // Simplified levels share the optimized vertices, so they are built last
+            std::vector<MeshLodLevel> lodLevels;
+            if (optimizeOptions.enabled && optimizeOptions.lodLevels > 0) {
+                lodLevels = MeshSimplifier::GenerateLods(vertices, indices, optimizeOptions);
+            }
+            outStats.lodCount = static_cast<uint32_t>(lodLevels.size()) + 1;
+
+            Mesh* resultMesh = new Mesh(vertices, indices, layout, lodLevels);
             resultMesh->SetMaterialIndex(static_cast<int>(mesh->mMaterialIndex));
             return resultMesh;
         }
@@ -1,5 +1,6 @@
 #pragma once
 #include "Mesh.h"
+#include "MeshOptimizer.h"
 #include "../Animation/Skeleton.h"
 #include "../Animation/AnimationClip.h"
 #include "../Math/Vectors/Vector3.h"
@@ -43,19 +44,23 @@ namespace RTBEngine {
             std::vector<LoadedMaterial> materials;
             std::vector<EmbeddedTexture> embeddedTextures;
             std::string modelDirectory;
+            std::vector<MeshOptimizeStats> optimizeStats;   // one per mesh
         };
 
         class ModelLoader {
         public:
-            static ModelData LoadModelWithAnimations(const std::string& path);
+            static ModelData LoadModelWithAnimations(const std::string& path,
+                const MeshOptimizeOptions& optimizeOptions = MeshOptimizeOptions());
 
-            static std::vector<Mesh*> LoadModel(const std::string& path);
+            static std::vector<Mesh*> LoadModel(const std::string& path,
+                const MeshOptimizeOptions& optimizeOptions = MeshOptimizeOptions());
 
         private:
-            static void ProcessNode(const aiNode* node, const aiScene* scene,
-                std::vector<Mesh*>& meshes, std::shared_ptr<Animation::Skeleton>& skeleton);
+            static void ProcessNode(const aiNode* node, const aiScene* scene, ModelData& outData,
+                const MeshOptimizeOptions& optimizeOptions);
             static Mesh* ProcessMesh(aiMesh* mesh, const aiScene* scene,
-                std::shared_ptr<Animation::Skeleton>& skeleton);
+                std::shared_ptr<Animation::Skeleton>& skeleton, const MeshOptimizeOptions& optimizeOptions,
+                MeshOptimizeStats& outStats);
 
             // Animation extraction
             static void ExtractBoneInfo(aiMesh* mesh, std::vector<Vertex>& vertices,
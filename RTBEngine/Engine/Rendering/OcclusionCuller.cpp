@@ -0,0 +1,286 @@
+#include "OcclusionCuller.h"
+#include "../Core/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RTB_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        OcclusionCuller::OcclusionCuller()
+            : width(0)
+            , height(0)
+            , perspective(false)
+        {
+            SetResolution(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+        }
+
+        void OcclusionCuller::SetResolution(int newWidth, int newHeight)
+        {
+            width = (std::max(newWidth, 4) + 3) & ~3;
+            height = std::max(newHeight, 1);
+            depth.assign(static_cast<size_t>(width) * height, 0.0f);
+        }
+
+        void OcclusionCuller::BeginFrame(const Math::Matrix4& newViewProjection)
+        {
+            viewProjection = newViewProjection;
+            // Column-major: the bottom row (m[3], m[7], m[11]) is zero when w does not depend on depth
+            perspective = viewProjection[3] != 0.0f || viewProjection[7] != 0.0f || viewProjection[11] != 0.0f;
+            std::fill(depth.begin(), depth.end(), 0.0f);
+            occluders.clear();
+            stats.Reset();
+        }
+
+        void OcclusionCuller::AddOccluder(const std::vector<Math::Vector3>& positions, const std::vector<uint32_t>& indices,
+            const Math::Matrix4& worldMatrix)
+        {
+            if (positions.empty() || indices.size() < 3) return;
+            occluders.push_back({ &positions, &indices, worldMatrix });
+        }
+
+        void OcclusionCuller::Rasterize()
+        {
+            stats.occluders = static_cast<uint32_t>(occluders.size());
+            if (occluders.empty() || !perspective) return;
+
+            Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+
+            if (occluderTriangles.size() < occluders.size()) {
+                occluderTriangles.resize(occluders.size());
+            }
+            jobs.ParallelFor(occluders.size(), 1, [this](size_t begin, size_t end) {
+                std::vector<Math::Vector4> clipScratch;
+                for (size_t i = begin; i < end; ++i) {
+                    occluderTriangles[i].clear();
+                    SetupTriangles(occluders[i], occluderTriangles[i], clipScratch);
+                }
+            });
+
+            for (size_t i = 0; i < occluders.size(); ++i) {
+                stats.trianglesRasterized += static_cast<uint32_t>(occluderTriangles[i].size());
+            }
+
+            // Bands own disjoint rows, so they write the buffer without synchronisation
+            size_t bandCount = static_cast<size_t>((height + BAND_HEIGHT - 1) / BAND_HEIGHT);
+            jobs.ParallelFor(bandCount, 1, [this](size_t begin, size_t end) {
+                for (size_t band = begin; band < end; ++band) {
+                    int minY = static_cast<int>(band) * BAND_HEIGHT;
+                    RasterizeBand(minY, std::min(minY + BAND_HEIGHT, height) - 1);
+                }
+            });
+        }
+
+        void OcclusionCuller::SetupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& out,
+            std::vector<Math::Vector4>& clipScratch) const
+        {
+            Math::Matrix4 worldViewProjection = viewProjection * occluder.worldMatrix;
+
+            const std::vector<Math::Vector3>& positions = *occluder.positions;
+            clipScratch.resize(positions.size());
+            for (size_t i = 0; i < positions.size(); ++i) {
+                const Math::Vector3& p = positions[i];
+                clipScratch[i] = worldViewProjection * Math::Vector4(p.x, p.y, p.z, 1.0f);
+            }
+
+            const std::vector<uint32_t>& indices = *occluder.indices;
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                const Math::Vector4* corners[3] = {
+                    &clipScratch[indices[i + 0]], &clipScratch[indices[i + 1]], &clipScratch[indices[i + 2]]
+                };
+
+                // Signed distance to the GL near plane (z = -w); only clip when a corner is behind it
+                float distances[3];
+                int inside = 0;
+                for (int c = 0; c < 3; ++c) {
+                    distances[c] = corners[c]->z + corners[c]->w;
+                    if (distances[c] >= 0.0f) inside++;
+                }
+                if (inside == 0) continue;
+                if (inside == 3) {
+                    AddScreenTriangle(*corners[0], *corners[1], *corners[2], out);
+                    continue;
+                }
+
+                Math::Vector4 polygon[4];
+                int polygonSize = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int next = (c + 1) % 3;
+                    if (distances[c] >= 0.0f) polygon[polygonSize++] = *corners[c];
+                    if ((distances[c] >= 0.0f) != (distances[next] >= 0.0f)) {
+                        float t = distances[c] / (distances[c] - distances[next]);
+                        const Math::Vector4& a = *corners[c];
+                        const Math::Vector4& b = *corners[next];
+                        polygon[polygonSize++] = Math::Vector4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                            a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+                    }
+                }
+                for (int c = 1; c + 1 < polygonSize; ++c) {
+                    AddScreenTriangle(polygon[0], polygon[c], polygon[c + 1], out);
+                }
+            }
+        }
+
+        void OcclusionCuller::AddScreenTriangle(const Math::Vector4& v0, const Math::Vector4& v1, const Math::Vector4& v2,
+            std::vector<ScreenTriangle>& out) const
+        {
+            const Math::Vector4* corners[3] = { &v0, &v1, &v2 };
+            float x[3], y[3], z[3];
+            for (int c = 0; c < 3; ++c) {
+                float invW = 1.0f / corners[c]->w;
+                x[c] = (corners[c]->x * invW * 0.5f + 0.5f) * width;
+                y[c] = (corners[c]->y * invW * 0.5f + 0.5f) * height;
+                z[c] = invW;
+            }
+
+            // Counter-clockwise front faces as in GL; back faces are hidden behind the front ones anyway
+            float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (!(area > 0.0f)) return;
+
+            float minX = std::min(x[0], std::min(x[1], x[2]));
+            float maxX = std::max(x[0], std::max(x[1], x[2]));
+            float minY = std::min(y[0], std::min(y[1], y[2]));
+            float maxY = std::max(y[0], std::max(y[1], y[2]));
+
+            ScreenTriangle triangle;
+            // Pixels whose centre can lie inside
+            triangle.minX = std::max(static_cast<int>(std::ceil(minX - 0.5f)), 0);
+            triangle.maxX = std::min(static_cast<int>(std::floor(maxX - 0.5f)), width - 1);
+            triangle.minY = std::max(static_cast<int>(std::ceil(minY - 0.5f)), 0);
+            triangle.maxY = std::min(static_cast<int>(std::floor(maxY - 0.5f)), height - 1);
+            if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) return;
+
+            for (int e = 0; e < 3; ++e) {
+                int next = (e + 1) % 3;
+                triangle.edgeA[e] = y[e] - y[next];
+                triangle.edgeB[e] = x[next] - x[e];
+                triangle.edgeC[e] = -(triangle.edgeA[e] * x[e] + triangle.edgeB[e] * y[e]);
+            }
+
+            // 1/w is affine in screen space
+            float invArea = 1.0f / area;
+            triangle.depthX = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) * invArea;
+            triangle.depthY = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) * invArea;
+            triangle.depthC = z[0] - triangle.depthX * x[0] - triangle.depthY * y[0];
+            triangle.maxDepth = std::max(z[0], std::max(z[1], z[2]));
+
+            out.push_back(triangle);
+        }
+
+        void OcclusionCuller::RasterizeBand(int bandMinY, int bandMaxY)
+        {
+            for (const std::vector<ScreenTriangle>& triangles : occluderTriangles) {
+                for (const ScreenTriangle& triangle : triangles) {
+                    if (triangle.maxY < bandMinY || triangle.minY > bandMaxY) continue;
+
+                    int rowBegin = std::max(triangle.minY, bandMinY);
+                    int rowEnd = std::min(triangle.maxY, bandMaxY);
+                    int spanBegin = triangle.minX & ~3;
+
+                    for (int row = rowBegin; row <= rowEnd; ++row) {
+                        float centerY = row + 0.5f;
+                        float* pixels = &depth[static_cast<size_t>(row) * width];
+
+                        float rowEdge[3];
+                        for (int e = 0; e < 3; ++e) {
+                            rowEdge[e] = triangle.edgeB[e] * centerY + triangle.edgeC[e];
+                        }
+                        float rowDepth = triangle.depthY * centerY + triangle.depthC;
+
+#ifdef RTB_OCCLUSION_SSE2
+                        const __m128 zero = _mm_setzero_ps();
+                        const __m128 maxDepth = _mm_set1_ps(triangle.maxDepth);
+                        for (int x = spanBegin; x <= triangle.maxX; x += 4) {
+                            __m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                            __m128 mask = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[0]), centerX),
+                                _mm_set1_ps(rowEdge[0])), zero);
+                            mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[1]), centerX),
+                                _mm_set1_ps(rowEdge[1])), zero));
+                            mask = _mm_and_ps(mask, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[2]), centerX),
+                                _mm_set1_ps(rowEdge[2])), zero));
+                            if (_mm_movemask_ps(mask) == 0) continue;
+
+                            // Clamped so slivers never extrapolate in front of their own vertices
+                            __m128 z = _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.depthX), centerX),
+                                _mm_set1_ps(rowDepth)), maxDepth);
+                            __m128 current = _mm_loadu_ps(pixels + x);
+                            __m128 nearest = _mm_max_ps(current, z);
+                            _mm_storeu_ps(pixels + x, _mm_or_ps(_mm_and_ps(mask, nearest), _mm_andnot_ps(mask, current)));
+                        }
+#else
+                        for (int x = spanBegin; x <= triangle.maxX; ++x) {
+                            float centerX = x + 0.5f;
+                            if (triangle.edgeA[0] * centerX + rowEdge[0] < 0.0f) continue;
+                            if (triangle.edgeA[1] * centerX + rowEdge[1] < 0.0f) continue;
+                            if (triangle.edgeA[2] * centerX + rowEdge[2] < 0.0f) continue;
+
+                            float z = std::min(triangle.depthX * centerX + rowDepth, triangle.maxDepth);
+                            pixels[x] = std::max(pixels[x], z);
+                        }
+#endif
+                    }
+                }
+            }
+        }
+
+        bool OcclusionCuller::IsVisible(const Math::AABB& worldBounds)
+        {
+            stats.tested++;
+            if (!perspective) return true;
+
+            float minX = width, maxX = 0.0f, minY = height, maxY = 0.0f;
+            float nearest = 0.0f;
+            for (int corner = 0; corner < 8; ++corner) {
+                Math::Vector4 clip = viewProjection * Math::Vector4(
+                    (corner & 1) ? worldBounds.max.x : worldBounds.min.x,
+                    (corner & 2) ? worldBounds.max.y : worldBounds.min.y,
+                    (corner & 4) ? worldBounds.max.z : worldBounds.min.z,
+                    1.0f);
+
+                // A corner behind the near plane has no usable projection
+                if (clip.z + clip.w < 0.0f || clip.w <= 0.0f) return true;
+
+                float invW = 1.0f / clip.w;
+                float x = (clip.x * invW * 0.5f + 0.5f) * width;
+                float y = (clip.y * invW * 0.5f + 0.5f) * height;
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y);
+                nearest = std::max(nearest, invW);
+            }
+
+            // Every pixel the rectangle touches plus a one pixel ring. A silhouette edge cutting a pixel
+            // whose centre it covers leaves a neighbouring centre uncovered, which the ring reaches.
+            int x0 = std::max(static_cast<int>(std::floor(minX)) - 1, 0);
+            int x1 = std::min(static_cast<int>(std::ceil(maxX)), width - 1);
+            int y0 = std::max(static_cast<int>(std::floor(minY)) - 1, 0);
+            int y1 = std::min(static_cast<int>(std::ceil(maxY)), height - 1);
+            if (x0 > x1 || y0 > y1) return true;
+
+            // Occluders must be strictly nearer, by a margin relative to the box's distance
+            float threshold = nearest * (1.0f + DEPTH_EPSILON);
+            for (int row = y0; row <= y1; ++row) {
+                const float* pixels = &depth[static_cast<size_t>(row) * width];
+                int x = x0;
+#ifdef RTB_OCCLUSION_SSE2
+                const __m128 boxDepth = _mm_set1_ps(threshold);
+                for (; x + 3 <= x1; x += 4) {
+                    if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(pixels + x), boxDepth)) != 0) return true;
+                }
+#endif
+                for (; x <= x1; ++x) {
+                    if (pixels[x] <= threshold) return true;
+                }
+            }
+
+            stats.occluded++;
+            return false;
+        }
+
+    }
+}
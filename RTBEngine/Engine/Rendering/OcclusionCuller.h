@@ -0,0 +1,94 @@
+#pragma once
+#include "../Math/Math.h"
+#include "../Math/Geometry/AABB.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        struct OcclusionStats {
+            uint32_t occluders = 0;
+            uint32_t trianglesRasterized = 0;   // after near clipping and back-face culling
+            uint32_t tested = 0;
+            uint32_t occluded = 0;
+
+            void Reset() { *this = OcclusionStats(); }
+        };
+
+        // Software occlusion culling, entirely on the CPU. Occluder triangles are rasterized into a
+        // small buffer holding the nearest 1/w per pixel (0 = nothing drawn); a box is occluded when
+        // every pixel around its screen rectangle holds an occluder clearly nearer than the box's
+        // nearest corner. Coverage is sampled at pixel centres; growing the rectangle by a pixel keeps
+        // a box that peeks past a silhouette by less than a pixel visible, but gaps narrower than a
+        // buffer pixel between occluders are treated as closed. Only perspective views are culled:
+        // 1/w is constant under an orthographic projection. Triangle setup runs per occluder and
+        // rasterization per band of rows, both on the JobSystem; spans are filled four pixels at a
+        // time with SSE2 where available.
+        class OcclusionCuller {
+        public:
+            static constexpr int DEFAULT_WIDTH = 256;
+            static constexpr int DEFAULT_HEIGHT = 128;
+            static constexpr int BAND_HEIGHT = 16;
+            // An occluder must be this fraction of the box's distance nearer to hide it, so surfaces
+            // touching or coplanar with the box (including the box's own occluder) never cull it
+            static constexpr float DEPTH_EPSILON = 1.0e-3f;
+
+            OcclusionCuller();
+
+            // Width is rounded up to a multiple of 4 for the SIMD spans
+            void SetResolution(int width, int height);
+            int GetWidth() const { return width; }
+            int GetHeight() const { return height; }
+
+            // Clears the buffer and the occluder list for a new view
+            void BeginFrame(const Math::Matrix4& viewProjection);
+            // False for orthographic views, where nothing is rasterized and every box is visible
+            bool IsPerspective() const { return perspective; }
+
+            // Queues object-space triangles drawn with worldMatrix. The arrays must stay alive until Rasterize.
+            void AddOccluder(const std::vector<Math::Vector3>& positions, const std::vector<uint32_t>& indices,
+                const Math::Matrix4& worldMatrix);
+
+            void Rasterize();
+
+            // True whenever the box might be seen, including boxes crossing the near plane
+            bool IsVisible(const Math::AABB& worldBounds);
+
+            const std::vector<float>& GetDepthBuffer() const { return depth; }
+            const OcclusionStats& GetStats() const { return stats; }
+
+        private:
+            struct Occluder {
+                const std::vector<Math::Vector3>* positions;
+                const std::vector<uint32_t>* indices;
+                Math::Matrix4 worldMatrix;
+            };
+
+            // Edge functions (inside >= 0) and 1/w plane over buffer pixels
+            struct ScreenTriangle {
+                float edgeA[3], edgeB[3], edgeC[3];
+                float depthX, depthY, depthC;
+                float maxDepth;
+                int minX, maxX, minY, maxY;
+            };
+
+            void SetupTriangles(const Occluder& occluder, std::vector<ScreenTriangle>& out,
+                std::vector<Math::Vector4>& clipScratch) const;
+            void AddScreenTriangle(const Math::Vector4& v0, const Math::Vector4& v1, const Math::Vector4& v2,
+                std::vector<ScreenTriangle>& out) const;
+            void RasterizeBand(int bandMinY, int bandMaxY);
+
+            int width;
+            int height;
+            Math::Matrix4 viewProjection;
+            bool perspective;
+            std::vector<float> depth;   // width * height, row 0 at the bottom of the screen
+
+            std::vector<Occluder> occluders;
+            std::vector<std::vector<ScreenTriangle>> occluderTriangles;    // one list per occluder, reused
+            OcclusionStats stats;
+        };
+
+    }
+}
@@ -0,0 +1,276 @@
+#include "RenderQueue.h"
+#include "InstanceBuffer.h"
+#include <algorithm>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Hashed at compile time; resolved against each shader's reflected uniform table
+        static constexpr UniformId MODEL_UNIFORM("uModel");
+        static constexpr UniformId USE_INSTANCING_UNIFORM("uUseInstancing");
+        static constexpr UniformId HAS_ANIMATION_UNIFORM("uHasAnimation");
+        static constexpr UniformId BONE_OFFSET_UNIFORM("uBoneOffset");
+        static constexpr UniformId POSITION_SCALE_UNIFORM("uPositionScale");
+        static constexpr UniformId POSITION_BIAS_UNIFORM("uPositionBias");
+
+        uint64_t RenderQueue::MakeSortKey(uint32_t layer, uint32_t shaderId, uint32_t textureId,
+            uint32_t materialId, uint32_t meshId, float normalizedDepth)
+        {
+            // Front-to-back within a batch so early depth testing rejects hidden fragments
+            float depth = std::min(std::max(normalizedDepth, 0.0f), 1.0f);
+            uint64_t depthBits = static_cast<uint64_t>(depth * static_cast<float>((1u << 14) - 1));
+
+            return (static_cast<uint64_t>(layer & 0x3u) << 62)
+                | (static_cast<uint64_t>(shaderId & 0x3FFu) << 52)
+                | (static_cast<uint64_t>(textureId & 0xFFFu) << 40)
+                | (static_cast<uint64_t>(materialId & 0x3FFFu) << 26)
+                | (static_cast<uint64_t>(meshId & 0xFFFu) << 14)
+                | depthBits;
+        }
+
+        void RenderQueue::Clear()
+        {
+            items.clear();
+        }
+
+        void RenderQueue::Submit(const DrawItem& item)
+        {
+            items.push_back(item);
+        }
+
+        void RenderQueue::Sort()
+        {
+            std::sort(items.begin(), items.end(), [](const DrawItem& a, const DrawItem& b) {
+                return a.sortKey < b.sortKey;
+            });
+        }
+
+        size_t RenderQueue::FindInstanceRun(size_t begin, bool matchMaterial) const
+        {
+            const DrawItem& first = items[begin];
+            size_t end = begin + 1;
+
+            // Skinned items carry their own bone palette and are always drawn alone
+            if (first.boneOffset >= 0) return end;
+
+            while (end < items.size()) {
+                const DrawItem& next = items[end];
+                if (next.mesh != first.mesh || next.lod != first.lod || next.boneOffset >= 0) break;
+                if (matchMaterial && next.material != first.material) break;
+                ++end;
+            }
+            return end;
+        }
+
+        size_t RenderQueue::FindIndirectBucket(size_t begin, bool matchMaterial) const
+        {
+            const DrawItem& first = items[begin];
+            size_t end = begin;
+            if (first.boneOffset >= 0) return end;
+
+            const GeometryAllocation& firstGeometry = first.mesh->GetGeometry();
+            while (end < items.size()) {
+                const DrawItem& next = items[end];
+                const GeometryAllocation& geometry = next.mesh->GetGeometry();
+                if (next.boneOffset >= 0 || !geometry.valid) break;
+                if (geometry.layout != firstGeometry.layout || geometry.indexType != firstGeometry.indexType) break;
+                if (matchMaterial && next.material != first.material) break;
+                ++end;
+            }
+            return end;
+        }
+
+        InstanceData RenderQueue::MakeInstance(const DrawItem& item)
+        {
+            const VertexQuantization& quantization = item.mesh->GetQuantization();
+
+            InstanceData instance;
+            instance.model = *item.modelMatrix;
+            instance.positionScale[0] = quantization.scale.x;
+            instance.positionScale[1] = quantization.scale.y;
+            instance.positionScale[2] = quantization.scale.z;
+            instance.positionScale[3] = 0.0f;
+            instance.positionBias[0] = quantization.bias.x;
+            instance.positionBias[1] = quantization.bias.y;
+            instance.positionBias[2] = quantization.bias.z;
+            instance.positionBias[3] = 0.0f;
+            return instance;
+        }
+
+        void RenderQueue::DrawRun(Shader* shader, size_t begin, size_t end, bool& instancingEnabled, RenderPassStats* stats)
+        {
+            const DrawItem& first = items[begin];
+            size_t count = end - begin;
+
+            if (count > 1) {
+                instances.clear();
+                for (size_t i = begin; i < end; ++i) {
+                    instances.push_back(MakeInstance(items[i]));
+                }
+                GLintptr offset = InstanceBuffer::GetInstance().Write(instances.data(), count);
+
+                if (!instancingEnabled) {
+                    shader->SetBool(USE_INSTANCING_UNIFORM, true);
+                    shader->SetBool(HAS_ANIMATION_UNIFORM, false);
+                    instancingEnabled = true;
+                }
+                first.mesh->DrawInstanced(offset, static_cast<GLsizei>(count), first.lod);
+            }
+            else {
+                if (instancingEnabled) {
+                    shader->SetBool(USE_INSTANCING_UNIFORM, false);
+                    instancingEnabled = false;
+                }
+
+                shader->SetMatrix4(MODEL_UNIFORM, *first.modelMatrix);
+
+                // Packed positions are relative to the mesh bounds; repeats are dropped by the shader's shadow copy
+                const VertexQuantization& quantization = first.mesh->GetQuantization();
+                shader->SetVector3(POSITION_SCALE_UNIFORM, quantization.scale);
+                shader->SetVector3(POSITION_BIAS_UNIFORM, quantization.bias);
+
+                if (first.boneOffset >= 0) {
+                    shader->SetBool(HAS_ANIMATION_UNIFORM, true);
+                    shader->SetInt(BONE_OFFSET_UNIFORM, first.boneOffset);
+                }
+                else {
+                    shader->SetBool(HAS_ANIMATION_UNIFORM, false);
+                }
+
+                first.mesh->Draw(first.lod);
+            }
+
+            if (stats) stats->drawCalls++;
+        }
+
+        void RenderQueue::DrawIndirect(Shader* shader, size_t begin, size_t end, bool& instancingEnabled, RenderPassStats* stats)
+        {
+            instances.clear();
+            indirectCommands.clear();
+
+            for (size_t run = begin; run < end;) {
+                // The bucket already matched materials; the run must not leave it
+                size_t runEnd = std::min(FindInstanceRun(run, false), end);
+                const Mesh* mesh = items[run].mesh;
+                const GeometryAllocation& geometry = mesh->GetGeometry();
+                const MeshLod& lod = mesh->GetLod(items[run].lod);
+
+                DrawElementsIndirectCommand command;
+                command.count = lod.indexCount;
+                command.instanceCount = static_cast<uint32_t>(runEnd - run);
+                command.firstIndex = static_cast<uint32_t>(geometry.indexOffset / geometry.GetIndexSize()) + lod.firstIndex;
+                command.baseVertex = geometry.baseVertex;
+                command.baseInstance = static_cast<uint32_t>(instances.size());
+                indirectCommands.push_back(command);
+
+                for (size_t i = run; i < runEnd; ++i) {
+                    instances.push_back(MakeInstance(items[i]));
+                }
+                run = runEnd;
+            }
+
+            // Commands were numbered from this bucket's first record; rebase them onto the buffer
+            GLintptr offset = InstanceBuffer::GetInstance().Write(instances.data(), instances.size());
+            uint32_t firstRecord = static_cast<uint32_t>(offset / sizeof(InstanceData));
+            for (DrawElementsIndirectCommand& command : indirectCommands) {
+                command.baseInstance += firstRecord;
+            }
+
+            if (!instancingEnabled) {
+                shader->SetBool(USE_INSTANCING_UNIFORM, true);
+                shader->SetBool(HAS_ANIMATION_UNIFORM, false);
+                instancingEnabled = true;
+            }
+
+            const GeometryAllocation& geometry = items[begin].mesh->GetGeometry();
+            IndirectDrawBuffer::GetInstance().Draw(geometry.layout, geometry.indexType,
+                indirectCommands.data(), indirectCommands.size());
+
+            if (stats) {
+                stats->drawCalls++;
+                stats->indirectCommands += static_cast<uint32_t>(indirectCommands.size());
+            }
+        }
+
+        size_t RenderQueue::DrawNext(Shader* shader, size_t begin, bool matchMaterial, bool& instancingEnabled, RenderPassStats* stats)
+        {
+            size_t runEnd = FindInstanceRun(begin, matchMaterial);
+
+            // Indirect only pays off once the bucket holds more than one mesh
+            if (IndirectDrawBuffer::GetInstance().IsEnabled()) {
+                size_t bucketEnd = FindIndirectBucket(begin, matchMaterial);
+                if (bucketEnd > runEnd) {
+                    DrawIndirect(shader, begin, bucketEnd, instancingEnabled, stats);
+                    return bucketEnd;
+                }
+            }
+
+            DrawRun(shader, begin, runEnd, instancingEnabled, stats);
+            return runEnd;
+        }
+
+        void RenderQueue::Execute(RenderPassStats* stats)
+        {
+            if (items.empty()) return;
+
+            Shader* currentShader = nullptr;
+            Material* currentMaterial = nullptr;
+            Texture* currentTexture = nullptr;
+            bool instancingEnabled = false;
+
+            size_t index = 0;
+            while (index < items.size()) {
+                const DrawItem& item = items[index];
+                Shader* shader = item.material->GetShader();
+
+                if (shader != currentShader) {
+                    shader->Bind();
+                    shader->SetBool(USE_INSTANCING_UNIFORM, false);
+                    instancingEnabled = false;
+                    currentShader = shader;
+                    // Material uniforms live in the program, so the new program needs them again
+                    currentMaterial = nullptr;
+                    if (stats) stats->shaderChanges++;
+                }
+
+                Texture* texture = item.material->GetTexture();
+                if (texture && texture != currentTexture) {
+                    texture->Bind(0);
+                    currentTexture = texture;
+                    if (stats) stats->textureChanges++;
+                }
+
+                if (item.material != currentMaterial) {
+                    item.material->ApplyProperties();
+                    currentMaterial = item.material;
+                    if (stats) stats->materialChanges++;
+                }
+
+                index = DrawNext(shader, index, true, instancingEnabled, stats);
+            }
+
+            // Program and texture stay bound; the state cache skips them if the next pass wants the same
+            if (instancingEnabled) {
+                currentShader->SetBool(USE_INSTANCING_UNIFORM, false);
+            }
+        }
+
+        void RenderQueue::ExecuteDepthOnly(Shader* shader, RenderPassStats* stats)
+        {
+            if (!shader || items.empty()) return;
+
+            bool instancingEnabled = false;
+            shader->SetBool(USE_INSTANCING_UNIFORM, false);
+
+            size_t index = 0;
+            while (index < items.size()) {
+                index = DrawNext(shader, index, false, instancingEnabled, stats);
+            }
+
+            if (instancingEnabled) {
+                shader->SetBool(USE_INSTANCING_UNIFORM, false);
+            }
+        }
+
+    }
+}
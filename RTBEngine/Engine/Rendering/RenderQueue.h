@@ -0,0 +1,80 @@
+#pragma once
+#include "Mesh.h"
+#include "Material.h"
+#include "RenderStats.h"
+#include "InstanceBuffer.h"
+#include "IndirectDrawBuffer.h"
+#include "../Math/Math.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // One mesh draw, recorded during submission and executed after sorting.
+        // Pointers must stay valid until Execute (they point into components and resources).
+        struct DrawItem {
+            uint64_t sortKey = 0;
+            Mesh* mesh = nullptr;
+            // Batched by pointer, so identical materials must be the same object
+            // (ResourceManager::GetSharedMaterial). Unused by depth-only passes.
+            Material* material = nullptr;
+            const Math::Matrix4* modelMatrix = nullptr;
+            int32_t boneOffset = -1;  // First matrix in the bone palette buffer, -1 when not skinned
+            uint32_t lod = 0;         // Detail level of mesh, clamped by Mesh::GetLod
+        };
+
+        // Collects draws for a pass, sorts them by state and issues them so that shader, texture and
+        // material state only change when the next item actually differs. Consecutive unskinned items
+        // with the same mesh and material are merged into one instanced draw; with IndirectDrawBuffer
+        // enabled, all unskinned meshes of a material bucket go out as one multi-draw indirect.
+        class RenderQueue {
+        public:
+            // Key layout, most significant first:
+            //   layer(2) | shader(10) | texture(12) | material(14) | mesh(12) | depth(14)
+            // Texture sits above material because rebinding a texture costs more than re-uploading
+            // the few material uniforms; mesh sits above depth so instances of a mesh end up adjacent.
+            // Ids are truncated; collisions only cost batching, never correctness.
+            static uint64_t MakeSortKey(uint32_t layer, uint32_t shaderId, uint32_t textureId,
+                uint32_t materialId, uint32_t meshId, float normalizedDepth);
+
+            void Clear();
+            void Submit(const DrawItem& item);
+            void Sort();
+
+            // Draws every item; camera and light data come from the FrameUniforms blocks.
+            // The last program and texture stay bound; the state cache skips rebinding them.
+            void Execute(RenderPassStats* stats = nullptr);
+
+            // Draws every item with an already bound depth shader (shadow maps); materials are ignored
+            void ExecuteDepthOnly(Shader* shader, RenderPassStats* stats = nullptr);
+
+            size_t GetSize() const { return items.size(); }
+            const std::vector<DrawItem>& GetItems() const { return items; }
+
+            // End of the run of sorted items starting at begin that can share one instanced draw
+            size_t FindInstanceRun(size_t begin, bool matchMaterial) const;
+
+        private:
+            // End of the run of unskinned items starting at begin that one indirect draw can cover:
+            // same material (if matchMaterial), vertex layout and index type
+            size_t FindIndirectBucket(size_t begin, bool matchMaterial) const;
+
+            // Draws items [begin, end) with shader, instanced when there is more than one
+            void DrawRun(Shader* shader, size_t begin, size_t end, bool& instancingEnabled, RenderPassStats* stats);
+
+            // Draws a bucket from FindIndirectBucket with one command per instance run
+            void DrawIndirect(Shader* shader, size_t begin, size_t end, bool& instancingEnabled, RenderPassStats* stats);
+
+            // Draws [begin, ...) one way or the other and returns the first item not drawn
+            size_t DrawNext(Shader* shader, size_t begin, bool matchMaterial, bool& instancingEnabled, RenderPassStats* stats);
+
+            static InstanceData MakeInstance(const DrawItem& item);
+
+            std::vector<DrawItem> items;
+            std::vector<InstanceData> instances;
+            std::vector<DrawElementsIndirectCommand> indirectCommands;
+        };
+
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // Per-pass counters, reset at the start of every frame
+        struct RenderPassStats {
+            uint32_t drawn = 0;
+            uint32_t culled = 0;
+            uint32_t occluded = 0;      // inside the frustum but hidden behind occluders
+
+            // GL work issued by the pass
+            uint32_t drawCalls = 0;
+            uint32_t shaderChanges = 0;
+            uint32_t textureChanges = 0;
+            uint32_t materialChanges = 0;
+
+            // Meshes drawn through multi-draw indirect; each bucket counts as one draw call
+            uint32_t indirectCommands = 0;
+
+            // Shadow pass only: cascades whose cached static-caster depth had to be re-rendered
+            uint32_t staticCacheRebuilds = 0;
+
+            void Reset() { *this = RenderPassStats(); }
+        };
+
+        struct RenderStats {
+            RenderPassStats shadowPass;
+            RenderPassStats geometryPass;
+
+            void Reset() {
+                shadowPass.Reset();
+                geometryPass.Reset();
+            }
+        };
+
+    }
+}
@@ -4,4 +4,9 @@
 #include "Mesh.h"
 #include "Texture.h"
 #include "Material.h"
-#include "ModelLoader.h"
\ No newline at end of file
+#include "ModelLoader.h"
+#include "RenderQueue.h"
+#include "InstanceBuffer.h"
+#include "GLStateCache.h"
+#include "GeometryArena.h"
+#include "IndirectDrawBuffer.h"
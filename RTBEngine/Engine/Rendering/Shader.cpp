@@ -2,6 +2,9 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include "GLStateCache.h"
 #include "../RTBEngine.h"
 
 namespace RTBEngine {
@@ -47,45 +50,222 @@ namespace RTBEngine {
             glDeleteShader(vertexShader);
             glDeleteShader(fragmentShader);
 
+            if (success) {
+                ReflectUniforms();
+            }
+
             isCompiled = success;
             return success;
         }
 
         void Shader::Bind() const {
-            glUseProgram(programID);
+            GLStateCache::GetInstance().UseProgram(programID);
         }
 
         void Shader::Unbind() const {
-            glUseProgram(0);
+            GLStateCache::GetInstance().UseProgram(0);
         }
 
         void Shader::SetBool(const std::string& name, bool value)
         {
-            glUniform1i(GetUniformLocation(name), value);
+            SetBool(GetUniformHandle(name), value);
         }
 
         void Shader::SetInt(const std::string& name, int value) {
-            glUniform1i(GetUniformLocation(name), value);
+            SetInt(GetUniformHandle(name), value);
         }
 
         void Shader::SetFloat(const std::string& name, float value) {
-            glUniform1f(GetUniformLocation(name), value);
+            SetFloat(GetUniformHandle(name), value);
         }
 
         void Shader::SetVector2(const std::string& name, const Math::Vector2& value) {
-            glUniform2f(GetUniformLocation(name), value.x, value.y);
+            SetVector2(GetUniformHandle(name), value);
         }
 
         void Shader::SetVector3(const std::string& name, const Math::Vector3& value) {
-            glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
+            SetVector3(GetUniformHandle(name), value);
         }
 
         void Shader::SetVector4(const std::string& name, const Math::Vector4& value) {
-            glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
+            SetVector4(GetUniformHandle(name), value);
         }
 
         void Shader::SetMatrix4(const std::string& name, const Math::Matrix4& value) {
-            glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, value.m);
+            SetMatrix4(GetUniformHandle(name), value);
+        }
+
+        void Shader::SetBool(UniformHandle handle, bool value) {
+            SetInt(handle, value ? 1 : 0);
+        }
+
+        void Shader::SetInt(UniformHandle handle, int value) {
+            if (UpdateShadow(handle, &value, 1)) {
+                glUniform1i(uniforms[handle.index].location, value);
+            }
+        }
+
+        void Shader::SetFloat(UniformHandle handle, float value) {
+            if (UpdateShadow(handle, &value, 1)) {
+                glUniform1f(uniforms[handle.index].location, value);
+            }
+        }
+
+        void Shader::SetVector2(UniformHandle handle, const Math::Vector2& value) {
+            float data[2] = { value.x, value.y };
+            if (UpdateShadow(handle, data, 2)) {
+                glUniform2fv(uniforms[handle.index].location, 1, data);
+            }
+        }
+
+        void Shader::SetVector3(UniformHandle handle, const Math::Vector3& value) {
+            float data[3] = { value.x, value.y, value.z };
+            if (UpdateShadow(handle, data, 3)) {
+                glUniform3fv(uniforms[handle.index].location, 1, data);
+            }
+        }
+
+        void Shader::SetVector4(UniformHandle handle, const Math::Vector4& value) {
+            float data[4] = { value.x, value.y, value.z, value.w };
+            if (UpdateShadow(handle, data, 4)) {
+                glUniform4fv(uniforms[handle.index].location, 1, data);
+            }
+        }
+
+        void Shader::SetMatrix4(UniformHandle handle, const Math::Matrix4& value) {
+            if (UpdateShadow(handle, value.m, 16)) {
+                glUniformMatrix4fv(uniforms[handle.index].location, 1, GL_FALSE, value.m);
+            }
+        }
+
+        bool Shader::UpdateShadow(UniformHandle handle, const void* value, uint32_t words) {
+            if (!handle.IsValid() || handle.index >= static_cast<int32_t>(uniforms.size())) {
+                return false;
+            }
+
+            UniformInfo& info = uniforms[handle.index];
+            if (words > info.shadowWords) {
+                // Setter does not match the declared type; upload without caching
+                info.hasValue = false;
+                return true;
+            }
+
+            uint32_t* slot = shadowValues.data() + info.shadowOffset;
+            if (info.hasValue && std::memcmp(slot, value, words * sizeof(uint32_t)) == 0) {
+                return false;
+            }
+
+            std::memcpy(slot, value, words * sizeof(uint32_t));
+            info.hasValue = true;
+            return true;
+        }
+
+        UniformHandle Shader::GetUniformHandle(const std::string& name) {
+            auto it = handleCache.find(name);
+            if (it != handleCache.end()) {
+                return UniformHandle{ it->second };
+            }
+
+            UniformHandle handle;
+            for (size_t i = 0; i < uniforms.size(); ++i) {
+                if (uniforms[i].name == name) {
+                    handle.index = static_cast<int32_t>(i);
+                    break;
+                }
+            }
+            handleCache[name] = handle.index;
+            return handle;
+        }
+
+        UniformHandle Shader::GetUniformHandle(UniformId id) const {
+            auto it = std::lower_bound(uniformsByHash.begin(), uniformsByHash.end(), id.hash,
+                [](const std::pair<uint32_t, int32_t>& entry, uint32_t hash) { return entry.first < hash; });
+            if (it != uniformsByHash.end() && it->first == id.hash) {
+                return UniformHandle{ it->second };
+            }
+            return UniformHandle{};
+        }
+
+        static uint32_t UniformTypeWords(GLenum type) {
+            switch (type) {
+            case GL_FLOAT: case GL_INT: case GL_UNSIGNED_INT: case GL_BOOL: return 1;
+            case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_BOOL_VEC2: return 2;
+            case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_BOOL_VEC3: return 3;
+            case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_BOOL_VEC4: case GL_FLOAT_MAT2: return 4;
+            case GL_FLOAT_MAT3: return 9;
+            case GL_FLOAT_MAT4: return 16;
+            default: return 1;  // Samplers and images are set as ints
+            }
+        }
+
+        void Shader::ReflectUniforms() {
+            uniforms.clear();
+            uniformsByHash.clear();
+            shadowValues.clear();
+            handleCache.clear();
+
+            GLint count = 0;
+            GLint maxNameLength = 0;
+            glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count);
+            glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+            std::vector<GLchar> nameBuffer(maxNameLength > 0 ? maxNameLength : 1);
+            uint32_t shadowSize = 0;
+
+            for (GLint i = 0; i < count; ++i) {
+                GLint arraySize = 0;
+                GLenum type = 0;
+                GLsizei length = 0;
+                glGetActiveUniform(programID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                    &length, &arraySize, &type, nameBuffer.data());
+
+                std::string name(nameBuffer.data(), length);
+
+                // Arrays are reported once as "name[0]"; give every element its own entry
+                std::string baseName = name;
+                bool isArray = name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0;
+                if (isArray) {
+                    baseName = name.substr(0, name.size() - 3);
+                }
+
+                for (GLint element = 0; element < arraySize; ++element) {
+                    std::string elementName = isArray ? baseName + "[" + std::to_string(element) + "]" : name;
+                    GLint location = glGetUniformLocation(programID, elementName.c_str());
+                    // Members of uniform blocks have no location and are not set through this API
+                    if (location < 0) continue;
+
+                    UniformInfo info;
+                    info.name = elementName;
+                    info.hash = HashUniformName(elementName.c_str());
+                    info.location = location;
+                    info.shadowWords = UniformTypeWords(type);
+                    info.shadowOffset = shadowSize;
+                    info.hasValue = false;
+                    shadowSize += info.shadowWords;
+
+                    uniforms.push_back(info);
+
+                    // "name" addresses element 0 as well, as in glGetUniformLocation
+                    if (isArray && element == 0) {
+                        handleCache[baseName] = static_cast<int32_t>(uniforms.size() - 1);
+                        uniformsByHash.emplace_back(HashUniformName(baseName.c_str()), static_cast<int32_t>(uniforms.size() - 1));
+                    }
+                }
+            }
+
+            shadowValues.assign(shadowSize, 0);
+
+            for (size_t i = 0; i < uniforms.size(); ++i) {
+                uniformsByHash.emplace_back(uniforms[i].hash, static_cast<int32_t>(i));
+            }
+            std::sort(uniformsByHash.begin(), uniformsByHash.end());
+
+            for (size_t i = 1; i < uniformsByHash.size(); ++i) {
+                if (uniformsByHash[i].first == uniformsByHash[i - 1].first
+                    && uniformsByHash[i].second != uniformsByHash[i - 1].second) {
+                    RTB_WARN("Shader: uniform name hash collision on " + uniforms[uniformsByHash[i].second].name);
+                }
+            }
         }
 
         GLuint Shader::CompileShader(GLenum type, const std::string& source) {
@@ -142,16 +322,5 @@ namespace RTBEngine {
             return buffer.str();
         }
 
-        GLint Shader::GetUniformLocation(const std::string& name) {
-            auto it = uniformCache.find(name);
-            if (it != uniformCache.end()) {
-                return it->second;
-            }
-
-            GLint location = glGetUniformLocation(programID, name.c_str());
-            uniformCache[name] = location;
-            return location;
-        }
-
     }
 }
\ No newline at end of file
@@ -2,11 +2,35 @@
 #include <GL/glew.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <cstdint>
 #include "../Math/Math.h"
 
 namespace RTBEngine {
     namespace Rendering {
 
+        // FNV-1a, usable at compile time for uniform names
+        constexpr uint32_t HashUniformName(const char* name) {
+            uint32_t hash = 2166136261u;
+            while (*name) {
+                hash = (hash ^ static_cast<uint8_t>(*name++)) * 16777619u;
+            }
+            return hash;
+        }
+
+        // Uniform name hashed at compile time: static constexpr UniformId MODEL("uModel");
+        class UniformId {
+        public:
+            constexpr explicit UniformId(const char* name) : hash(HashUniformName(name)) {}
+            uint32_t hash;
+        };
+
+        // Index into a shader's reflected uniform table; only valid for the shader that returned it
+        struct UniformHandle {
+            int32_t index = -1;
+            bool IsValid() const { return index >= 0; }
+        };
+
         class Shader {
         public:
             Shader();
@@ -32,15 +56,54 @@ namespace RTBEngine {
             void SetVector4(const std::string& name, const Math::Vector4& value);
             void SetMatrix4(const std::string& name, const Math::Matrix4& value);
 
+            // Handles are resolved from the table built at link time (glGetActiveUniform). Invalid
+            // handles are ignored, like unknown names. Setting the value a uniform already holds is skipped.
+            UniformHandle GetUniformHandle(const std::string& name);
+            UniformHandle GetUniformHandle(UniformId id) const;
+
+            void SetBool(UniformHandle handle, bool value);
+            void SetInt(UniformHandle handle, int value);
+            void SetFloat(UniformHandle handle, float value);
+            void SetVector2(UniformHandle handle, const Math::Vector2& value);
+            void SetVector3(UniformHandle handle, const Math::Vector3& value);
+            void SetVector4(UniformHandle handle, const Math::Vector4& value);
+            void SetMatrix4(UniformHandle handle, const Math::Matrix4& value);
+
+            void SetBool(UniformId id, bool value) { SetBool(GetUniformHandle(id), value); }
+            void SetInt(UniformId id, int value) { SetInt(GetUniformHandle(id), value); }
+            void SetFloat(UniformId id, float value) { SetFloat(GetUniformHandle(id), value); }
+            void SetVector2(UniformId id, const Math::Vector2& value) { SetVector2(GetUniformHandle(id), value); }
+            void SetVector3(UniformId id, const Math::Vector3& value) { SetVector3(GetUniformHandle(id), value); }
+            void SetVector4(UniformId id, const Math::Vector4& value) { SetVector4(GetUniformHandle(id), value); }
+            void SetMatrix4(UniformId id, const Math::Matrix4& value) { SetMatrix4(GetUniformHandle(id), value); }
+
+            size_t GetUniformCount() const { return uniforms.size(); }
+
         private:
+            struct UniformInfo {
+                std::string name;
+                uint32_t hash;
+                GLint location;
+                uint32_t shadowOffset;   // In 32-bit words into shadowValues
+                uint32_t shadowWords;
+                bool hasValue;
+            };
+
+            void ReflectUniforms();
+            // Copies value into the shadow slot; false when it already held exactly that value
+            bool UpdateShadow(UniformHandle handle, const void* value, uint32_t words);
+
             GLuint CompileShader(GLenum type, const std::string& source);
             bool LinkProgram(GLuint vertexShader, GLuint fragmentShader);
             std::string ReadFile(const std::string& filePath);
-            GLint GetUniformLocation(const std::string& name);
 
             GLuint programID;
             bool isCompiled;
-            std::unordered_map<std::string, GLint> uniformCache;
+
+            std::vector<UniformInfo> uniforms;
+            std::vector<std::pair<uint32_t, int32_t>> uniformsByHash;  // Sorted by hash
+            std::vector<uint32_t> shadowValues;
+            std::unordered_map<std::string, int32_t> handleCache;      // String convenience layer, includes misses
         };
 
     }
@@ -0,0 +1,62 @@
+#include "ShaderStorageBuffer.h"
+#include "GraphicsContext.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        ShaderStorageBuffer::ShaderStorageBuffer()
+            : bufferID(0), bindingPoint(0), capacity(0)
+        {
+        }
+
+        ShaderStorageBuffer::~ShaderStorageBuffer()
+        {
+            Shutdown();
+        }
+
+        bool ShaderStorageBuffer::Initialize(GLuint bindingPoint, size_t initialCapacity)
+        {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
+            Shutdown();
+
+            this->bindingPoint = bindingPoint;
+            capacity = initialCapacity > 0 ? initialCapacity : 1;
+
+            glGenBuffers(1, &bufferID);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferID);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindingPoint, bufferID);
+            return true;
+        }
+
+        void ShaderStorageBuffer::Shutdown()
+        {
+            if (bufferID != 0) {
+                glDeleteBuffers(1, &bufferID);
+                bufferID = 0;
+            }
+            capacity = 0;
+        }
+
+        void ShaderStorageBuffer::Upload(const void* data, size_t size)
+        {
+            if (bufferID == 0 || size == 0) return;
+
+            while (capacity < size) {
+                capacity *= 2;
+            }
+
+            // Orphan the previous frame's storage so the upload never waits on draws still reading it
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, bufferID);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, data);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        }
+
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // GL shader storage buffer attached to a fixed binding point (layout(std430, binding = N)).
+        // Sized for streaming: every Upload orphans the old storage and grows it when needed.
+        class ShaderStorageBuffer {
+        public:
+            ShaderStorageBuffer();
+            ~ShaderStorageBuffer();
+
+            ShaderStorageBuffer(const ShaderStorageBuffer&) = delete;
+            ShaderStorageBuffer& operator=(const ShaderStorageBuffer&) = delete;
+
+            bool Initialize(GLuint bindingPoint, size_t initialCapacity);
+            void Shutdown();
+
+            void Upload(const void* data, size_t size);
+
+            GLuint GetBufferID() const { return bufferID; }
+            GLuint GetBindingPoint() const { return bindingPoint; }
+            size_t GetCapacity() const { return capacity; }
+
+        private:
+            GLuint bufferID;
+            GLuint bindingPoint;
+            size_t capacity;
+        };
+
+    }
+}
@@ -1,26 +1,43 @@
 #include "ShadowMap.h"
+#include "GraphicsContext.h"
+#include "GLStateCache.h"
 #include <GL/glew.h>
+#include <cstring>
 
 namespace RTBEngine {
     namespace Rendering {
 
-        ShadowMap::ShadowMap(int resolution) : resolution(resolution) {}
+        ShadowMap::ShadowMap(int resolution, int cascadeCount)
+            : resolution(resolution), cascadeCount(cascadeCount)
+        {
+        }
 
-        ShadowMap::~ShadowMap() {}
+        ShadowMap::~ShadowMap() {
+            GLuint textures[2] = { depthTextureID, staticDepthTextureID };
+            for (GLuint texture : textures) {
+                if (texture != 0) {
+                    glDeleteTextures(1, &texture);
+                    GLStateCache::GetInstance().OnTextureDeleted(texture);
+                }
+            }
+        }
 
         bool ShadowMap::Initialize() {
-            framebuffer = std::make_unique<Framebuffer>();
-            if (!framebuffer->Create()) {
+            if (!GraphicsContext::IsAvailable()) {
                 return false;
             }
 
-            depthTexture = std::make_unique<Texture>();
-            if (!depthTexture->CreateDepthTexture(resolution, resolution)) {
+            framebuffer = std::make_unique<Framebuffer>();
+            if (!framebuffer->Create()) {
                 return false;
             }
 
+            depthTextureID = CreateDepthArray();
+            staticDepthTextureID = CreateDepthArray();
+            InvalidateStaticCache();
+
             framebuffer->Bind();
-            framebuffer->AttachDepthTexture(depthTexture->GetID());
+            framebuffer->AttachDepthTextureLayer(depthTextureID, 0);
 
             if (!framebuffer->IsComplete()) {
                 return false;
@@ -30,17 +47,65 @@ namespace RTBEngine {
             return true;
         }
 
-        void ShadowMap::BindForWriting() const {
+        GLuint ShadowMap::CreateDepthArray() const {
+            GLuint textureID = 0;
+            glGenTextures(1, &textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D_ARRAY, textureID);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, resolution, resolution, cascadeCount, 0,
+                GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+            return textureID;
+        }
+
+        void ShadowMap::BindForWriting(int cascade) const {
             framebuffer->Bind();
+            framebuffer->AttachDepthTextureLayer(depthTextureID, cascade);
         }
 
         void ShadowMap::BindForReading(unsigned int textureUnit) const {
-            depthTexture->Bind(textureUnit);
+            GLStateCache::GetInstance().BindTexture(textureUnit, GL_TEXTURE_2D_ARRAY, depthTextureID);
         }
 
         void ShadowMap::Unbind() const {
             framebuffer->Unbind();
         }
 
+        bool ShadowMap::IsStaticLayerValid(int cascade, const Math::Matrix4& lightSpaceMatrix, uint64_t staticSignature) const {
+            const StaticLayer& layer = staticLayers[cascade];
+            return layer.valid && layer.signature == staticSignature
+                && std::memcmp(layer.lightSpaceMatrix.m, lightSpaceMatrix.m, sizeof(lightSpaceMatrix.m)) == 0;
+        }
+
+        void ShadowMap::BindStaticForWriting(int cascade) const {
+            framebuffer->Bind();
+            framebuffer->AttachDepthTextureLayer(staticDepthTextureID, cascade);
+        }
+
+        void ShadowMap::MarkStaticLayerValid(int cascade, const Math::Matrix4& lightSpaceMatrix, uint64_t staticSignature) {
+            StaticLayer& layer = staticLayers[cascade];
+            layer.lightSpaceMatrix = lightSpaceMatrix;
+            layer.signature = staticSignature;
+            layer.valid = true;
+        }
+
+        void ShadowMap::CopyStaticLayer(int cascade) const {
+            glCopyImageSubData(staticDepthTextureID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, cascade,
+                depthTextureID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, cascade,
+                resolution, resolution, 1);
+        }
+
+        void ShadowMap::InvalidateStaticCache() {
+            for (StaticLayer& layer : staticLayers) {
+                layer.valid = false;
+            }
+        }
+
     }
 }
@@ -1,31 +1,58 @@
 #pragma once
 #include <memory>
+#include <cstdint>
+#include <GL/glew.h>
 #include "Framebuffer.h"
-#include "Texture.h"
+#include "../Math/Math.h"
 
 namespace RTBEngine {
     namespace Rendering {
 
+        // Cascade splits are packed into a single vec4 on the shader side
+        constexpr int MAX_SHADOW_CASCADES = 4;
+
+        // Depth texture array with one layer per shadow cascade. A second array keeps the depth of
+        // static casters only; it is re-rendered when a cascade's projection or the static set changes
+        // and otherwise copied into the live layer before dynamic casters are drawn on top.
         class ShadowMap {
         public:
-            ShadowMap(int resolution = 1024);
+            ShadowMap(int resolution = 1024, int cascadeCount = 1);
             ~ShadowMap();
 
             ShadowMap(const ShadowMap&) = delete;
             ShadowMap& operator=(const ShadowMap&) = delete;
 
             bool Initialize();
-            void BindForWriting() const;
+            void BindForWriting(int cascade) const;
             void BindForReading(unsigned int textureUnit) const;
             void Unbind() const;
 
+            // Static caster cache
+            bool IsStaticLayerValid(int cascade, const Math::Matrix4& lightSpaceMatrix, uint64_t staticSignature) const;
+            void BindStaticForWriting(int cascade) const;
+            void MarkStaticLayerValid(int cascade, const Math::Matrix4& lightSpaceMatrix, uint64_t staticSignature);
+            void CopyStaticLayer(int cascade) const;
+            void InvalidateStaticCache();
+
             int GetResolution() const { return resolution; }
-            Texture* GetDepthTexture() { return depthTexture.get(); }
+            int GetCascadeCount() const { return cascadeCount; }
+            GLuint GetDepthTextureID() const { return depthTextureID; }
 
         private:
+            struct StaticLayer {
+                Math::Matrix4 lightSpaceMatrix;
+                uint64_t signature = 0;
+                bool valid = false;
+            };
+
+            GLuint CreateDepthArray() const;
+
             int resolution;
+            int cascadeCount;
             std::unique_ptr<Framebuffer> framebuffer;
-            std::unique_ptr<Texture> depthTexture;
+            GLuint depthTextureID = 0;
+            GLuint staticDepthTextureID = 0;
+            StaticLayer staticLayers[MAX_SHADOW_CASCADES];
         };
 
     }
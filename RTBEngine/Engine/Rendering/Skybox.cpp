@@ -2,6 +2,7 @@
 #include "Cubemap.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "GLStateCache.h"
 #include "../Math/Matrix/Matrix4.h"
 
 namespace RTBEngine {
@@ -86,7 +87,8 @@ namespace RTBEngine {
             glGenVertexArrays(1, &VAO);
             glGenBuffers(1, &VBO);
 
-            glBindVertexArray(VAO);
+            GLStateCache& state = GLStateCache::GetInstance();
+            state.BindVertexArray(VAO);
             glBindBuffer(GL_ARRAY_BUFFER, VBO);
             glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), skyboxVertices, GL_STATIC_DRAW);
 
@@ -94,12 +96,13 @@ namespace RTBEngine {
             glEnableVertexAttribArray(0);
             glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 
-            glBindVertexArray(0);
+            state.BindVertexArray(0);
         }
 
         void Skybox::DeleteCubeMesh() {
             if (VAO != 0) {
                 glDeleteVertexArrays(1, &VAO);
+                GLStateCache::GetInstance().OnVertexArrayDeleted(VAO);
                 VAO = 0;
             }
             if (VBO != 0) {
@@ -113,38 +116,26 @@ namespace RTBEngine {
                 return;
             }
 
-            glDisable(GL_CULL_FACE);
+            GLStateCache& state = GLStateCache::GetInstance();
+            state.SetCullFace(false);
 
             // Change depth function so skybox passes depth test at maximum depth (1.0)
-            glDepthFunc(GL_LEQUAL);
+            state.SetDepthFunc(GL_LEQUAL);
 
+            // View and projection come from the camera uniform block; the shader drops the translation
             shader->Bind();
-
-            // Remove translation from view matrix
-            // This makes the skybox appear infinitely far away
-            Math::Matrix4 view = camera->GetViewMatrix();
-            view.m[12] = 0.0f;  // Remove X translation
-            view.m[13] = 0.0f;  // Remove Y translation
-            view.m[14] = 0.0f;  // Remove Z translation
-
-            shader->SetMatrix4("uView", view);
-            shader->SetMatrix4("uProjection", camera->GetProjectionMatrix());
             shader->SetInt("uSkybox", 0);
 
             // Bind cubemap and draw
             cubemap->Bind(0);
 
-            glBindVertexArray(VAO);
+            state.BindVertexArray(VAO);
             glDrawArrays(GL_TRIANGLES, 0, 36);
-            glBindVertexArray(0);
-
-            cubemap->Unbind();
-            shader->Unbind();
 
             // Restore default depth function
-            glDepthFunc(GL_LESS);
+            state.SetDepthFunc(GL_LESS);
 
-            glEnable(GL_CULL_FACE);
+            state.SetCullFace(true);
         }
 
     }
@@ -1,4 +1,6 @@
 #include "Texture.h"
+#include "GraphicsContext.h"
+#include "GLStateCache.h"
 #include "../../ThirdParty/stb/stb_image.h"
 #include <iostream>
 #include "../RTBEngine.h"
@@ -15,11 +17,17 @@ namespace RTBEngine {
         {
             if (textureID != 0) {
                 glDeleteTextures(1, &textureID);
+                GLStateCache::GetInstance().OnTextureDeleted(textureID);
             }
         }
 
         bool Texture::LoadFromFile(const std::string& path)
         {
+            // Textures are GPU-only; nothing to keep without a context
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
             stbi_set_flip_vertically_on_load(true);
 
             unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
@@ -29,7 +37,7 @@ namespace RTBEngine {
             }
 
             glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, textureID);
 
             GLenum format = GL_RGB;
             if (channels == 1)
@@ -52,6 +60,10 @@ namespace RTBEngine {
 
         bool Texture::LoadFromMemory(const unsigned char* data, int w, int h, int ch)
         {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
             if (!data || w <= 0 || h <= 0 || ch <= 0) {
                 RTB_ERROR("Invalid texture data for LoadFromMemory");
                 return false;
@@ -62,7 +74,7 @@ namespace RTBEngine {
             channels = ch;
 
             glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, textureID);
 
             GLenum format = GL_RGB;
             if (channels == 1)
@@ -83,6 +95,10 @@ namespace RTBEngine {
 
         bool Texture::LoadFromCompressedMemory(const unsigned char* data, int dataSize)
         {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
             if (!data || dataSize <= 0) {
                 RTB_ERROR("Invalid compressed texture data");
                 return false;
@@ -100,7 +116,7 @@ namespace RTBEngine {
             }
 
             glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, textureID);
 
             GLenum format = GL_RGB;
             if (channels == 1)
@@ -122,20 +138,22 @@ namespace RTBEngine {
         }
 
         bool Texture::CreateDepthTexture(int width, int height) {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
             this->width = width;
             this->height = height;
             this->channels = 1;
 
             glGenTextures(1, &textureID);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, textureID);
 
             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0,
                 GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
 
             SetDepthTextureParams();
 
-            glBindTexture(GL_TEXTURE_2D, 0);
-
             return textureID != 0;
         }
 
@@ -153,25 +171,24 @@ namespace RTBEngine {
 
         void Texture::Bind(unsigned int slot) const
         {
-            glActiveTexture(GL_TEXTURE0 + slot);
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(slot, GL_TEXTURE_2D, textureID);
         }
 
-        void Texture::Unbind() const
+        void Texture::Unbind(unsigned int slot) const
         {
-            glBindTexture(GL_TEXTURE_2D, 0);
+            GLStateCache::GetInstance().BindTexture(slot, GL_TEXTURE_2D, 0);
         }
 
         void Texture::SetFilter(TextureFilter minFilter, TextureFilter magFilter)
         {
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, textureID);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GetGLFilter(minFilter));
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GetGLFilter(magFilter));
         }
 
         void Texture::SetWrap(TextureWrap wrapS, TextureWrap wrapT)
         {
-            glBindTexture(GL_TEXTURE_2D, textureID);
+            GLStateCache::GetInstance().BindTexture(0, GL_TEXTURE_2D, textureID);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GetGLWrap(wrapS));
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GetGLWrap(wrapT));
         }
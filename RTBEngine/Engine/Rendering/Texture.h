@@ -36,7 +36,7 @@ namespace RTBEngine {
             void SetDepthTextureParams();
 
             void Bind(unsigned int slot = 0) const;
-            void Unbind() const;
+            void Unbind(unsigned int slot = 0) const;
 
             void SetFilter(TextureFilter minFilter, TextureFilter magFilter);
             void SetWrap(TextureWrap wrapS, TextureWrap wrapT);
@@ -0,0 +1,56 @@
+#include "UniformBuffer.h"
+#include "GraphicsContext.h"
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        UniformBuffer::UniformBuffer()
+            : bufferID(0), bindingPoint(0), size(0)
+        {
+        }
+
+        UniformBuffer::~UniformBuffer()
+        {
+            Shutdown();
+        }
+
+        bool UniformBuffer::Initialize(GLuint bindingPoint, size_t size)
+        {
+            if (!GraphicsContext::IsAvailable()) {
+                return false;
+            }
+
+            Shutdown();
+
+            this->bindingPoint = bindingPoint;
+            this->size = size;
+
+            glGenBuffers(1, &bufferID);
+            glBindBuffer(GL_UNIFORM_BUFFER, bufferID);
+            glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+            glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, bufferID);
+            return true;
+        }
+
+        void UniformBuffer::Shutdown()
+        {
+            if (bufferID != 0) {
+                glDeleteBuffers(1, &bufferID);
+                bufferID = 0;
+            }
+            size = 0;
+        }
+
+        void UniformBuffer::Update(const void* data, size_t dataSize, size_t offset)
+        {
+            if (bufferID == 0 || offset + dataSize > size) return;
+
+            glBindBuffer(GL_UNIFORM_BUFFER, bufferID);
+            glBufferSubData(GL_UNIFORM_BUFFER, offset, dataSize, data);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+
+    }
+}
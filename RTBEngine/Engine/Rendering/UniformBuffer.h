@@ -0,0 +1,33 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // GL uniform buffer attached to a fixed binding point (matching layout(binding = N) in the shaders)
+        class UniformBuffer {
+        public:
+            UniformBuffer();
+            ~UniformBuffer();
+
+            UniformBuffer(const UniformBuffer&) = delete;
+            UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+            bool Initialize(GLuint bindingPoint, size_t size);
+            void Shutdown();
+
+            void Update(const void* data, size_t size, size_t offset = 0);
+
+            GLuint GetBufferID() const { return bufferID; }
+            GLuint GetBindingPoint() const { return bindingPoint; }
+            size_t GetSize() const { return size; }
+
+        private:
+            GLuint bufferID;
+            GLuint bindingPoint;
+            size_t size;
+        };
+
+    }
+}
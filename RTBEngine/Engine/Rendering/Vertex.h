@@ -7,14 +7,15 @@ namespace RTBEngine {
         // Maximum bones that can influence a single vertex
         constexpr int MAX_BONE_INFLUENCE = 4;
 
+        // Full-precision vertex used while importing; Mesh packs it into a VertexLayout for the GPU
         struct Vertex {
-            Math::Vector3 position;     // location 0
-            Math::Vector3 normal;       // location 1
-            Math::Vector2 texCoords;    // location 2
+            Math::Vector3 position;
+            Math::Vector3 normal;
+            Math::Vector2 texCoords;
 
             // Skeletal animation data
-            int boneIndices[MAX_BONE_INFLUENCE] = { 0, 0, 0, 0 };       // location 3
-            float boneWeights[MAX_BONE_INFLUENCE] = { 0.0f, 0.0f, 0.0f, 0.0f };  // location 4
+            int boneIndices[MAX_BONE_INFLUENCE] = { 0, 0, 0, 0 };
+            float boneWeights[MAX_BONE_INFLUENCE] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
             // Helper to add bone influence to this vertex
             void AddBoneInfluence(int boneIndex, float weight) {
@@ -0,0 +1,224 @@
+#include "VertexFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        static_assert(sizeof(StaticVertex) == 16, "StaticVertex must stay tightly packed");
+        static_assert(sizeof(SkinnedVertex) == 28, "SkinnedVertex must stay tightly packed");
+
+        static uint16_t ToUnorm16(float value)
+        {
+            return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+        }
+
+        static int16_t ToSnorm16(float value)
+        {
+            return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+        }
+
+        static uint16_t QuantizeAxis(float value, float scale, float bias)
+        {
+            return scale > 0.0f ? ToUnorm16((value - bias) / scale) : 0;
+        }
+
+        size_t VertexPacker::GetStride(VertexLayout layout)
+        {
+            return layout == VertexLayout::Skinned ? sizeof(SkinnedVertex) : sizeof(StaticVertex);
+        }
+
+        VertexQuantization VertexPacker::ComputeQuantization(const Math::AABB& bounds)
+        {
+            VertexQuantization quantization;
+            if (bounds.IsEmpty()) {
+                quantization.scale = Math::Vector3(0.0f, 0.0f, 0.0f);
+                quantization.bias = Math::Vector3(0.0f, 0.0f, 0.0f);
+            }
+            else {
+                quantization.scale = bounds.max - bounds.min;
+                quantization.bias = bounds.min;
+            }
+            return quantization;
+        }
+
+        std::vector<uint8_t> VertexPacker::Pack(const std::vector<Vertex>& vertices, VertexLayout layout,
+            const VertexQuantization& quantization)
+        {
+            size_t stride = GetStride(layout);
+            std::vector<uint8_t> packed(vertices.size() * stride);
+
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                const Vertex& vertex = vertices[i];
+
+                // SkinnedVertex starts with the StaticVertex members, so both layouts share this part
+                StaticVertex base;
+                base.position[0] = QuantizeAxis(vertex.position.x, quantization.scale.x, quantization.bias.x);
+                base.position[1] = QuantizeAxis(vertex.position.y, quantization.scale.y, quantization.bias.y);
+                base.position[2] = QuantizeAxis(vertex.position.z, quantization.scale.z, quantization.bias.z);
+                base.position[3] = 0;
+                EncodeOctahedral(vertex.normal, base.normal);
+                base.texCoords[0] = FloatToHalf(vertex.texCoords.x);
+                base.texCoords[1] = FloatToHalf(vertex.texCoords.y);
+
+                uint8_t* out = packed.data() + i * stride;
+                if (layout == VertexLayout::Static) {
+                    std::memcpy(out, &base, sizeof(base));
+                    continue;
+                }
+
+                SkinnedVertex skinned;
+                std::memcpy(skinned.position, base.position, sizeof(base.position));
+                std::memcpy(skinned.normal, base.normal, sizeof(base.normal));
+                std::memcpy(skinned.texCoords, base.texCoords, sizeof(base.texCoords));
+
+                // Influences on bones that do not fit in a byte are dropped and the rest renormalized
+                float weights[MAX_BONE_INFLUENCE];
+                float total = 0.0f;
+                for (int b = 0; b < MAX_BONE_INFLUENCE; ++b) {
+                    int boneIndex = vertex.boneIndices[b];
+                    bool valid = boneIndex >= 0 && boneIndex < MAX_PACKED_BONES && vertex.boneWeights[b] > 0.0f;
+                    skinned.boneIndices[b] = valid ? static_cast<uint8_t>(boneIndex) : 0;
+                    weights[b] = valid ? vertex.boneWeights[b] : 0.0f;
+                    total += weights[b];
+                }
+
+                // Quantized weights still sum to exactly 1: the rounding error goes to the largest one
+                int largest = 0;
+                int sum = 0;
+                for (int b = 0; b < MAX_BONE_INFLUENCE; ++b) {
+                    skinned.boneWeights[b] = total > 0.0f ? ToUnorm16(weights[b] / total) : 0;
+                    sum += skinned.boneWeights[b];
+                    if (skinned.boneWeights[b] > skinned.boneWeights[largest]) largest = b;
+                }
+                if (sum > 0) {
+                    skinned.boneWeights[largest] = static_cast<uint16_t>(skinned.boneWeights[largest] + 65535 - sum);
+                }
+
+                std::memcpy(out, &skinned, sizeof(skinned));
+            }
+
+            return packed;
+        }
+
+        uint16_t VertexPacker::FloatToHalf(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            uint32_t sign = (bits >> 16) & 0x8000u;
+            uint32_t floatExponent = (bits >> 23) & 0xFFu;
+            uint32_t mantissa = bits & 0x7FFFFFu;
+
+            if (floatExponent == 0xFFu) {
+                return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+            }
+
+            int exponent = static_cast<int>(floatExponent) - 127 + 15;
+            if (exponent >= 31) {
+                return static_cast<uint16_t>(sign | 0x7C00u);
+            }
+
+            if (exponent <= 0) {
+                // Subnormal half (or zero); round to nearest even on the shifted-out bits
+                if (exponent < -10) {
+                    return static_cast<uint16_t>(sign);
+                }
+                mantissa |= 0x800000u;
+                uint32_t shift = static_cast<uint32_t>(14 - exponent);
+                uint32_t half = mantissa >> shift;
+                uint32_t remainder = mantissa & ((1u << shift) - 1u);
+                uint32_t halfway = 1u << (shift - 1u);
+                if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+                    ++half;
+                }
+                return static_cast<uint16_t>(sign | half);
+            }
+
+            uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+            uint32_t remainder = mantissa & 0x1FFFu;
+            // A carry out of the mantissa correctly bumps the exponent (up to infinity)
+            if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+                ++half;
+            }
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        float VertexPacker::HalfToFloat(uint16_t value)
+        {
+            uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+            uint32_t exponent = (value >> 10) & 0x1Fu;
+            uint32_t mantissa = value & 0x3FFu;
+            uint32_t bits;
+
+            if (exponent == 0) {
+                if (mantissa == 0) {
+                    bits = sign;
+                }
+                else {
+                    // Subnormal half: renormalize into a float exponent
+                    exponent = 127 - 15 + 1;
+                    while (!(mantissa & 0x400u)) {
+                        mantissa <<= 1;
+                        --exponent;
+                    }
+                    bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+                }
+            }
+            else if (exponent == 31) {
+                bits = sign | 0x7F800000u | (mantissa << 13);
+            }
+            else {
+                bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+            }
+
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        void VertexPacker::EncodeOctahedral(const Math::Vector3& normal, int16_t out[2])
+        {
+            float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+            if (l1 <= 0.0f) {
+                out[0] = 0;
+                out[1] = 0;
+                return;
+            }
+
+            float x = normal.x / l1;
+            float y = normal.y / l1;
+            if (normal.z < 0.0f) {
+                // Fold the lower hemisphere over the diagonals
+                float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                x = foldedX;
+                y = foldedY;
+            }
+            out[0] = ToSnorm16(x);
+            out[1] = ToSnorm16(y);
+        }
+
+        Math::Vector3 VertexPacker::DecodeOctahedral(const int16_t encoded[2])
+        {
+            // Same decode as the vertex shaders
+            float x = std::max(encoded[0] / 32767.0f, -1.0f);
+            float y = std::max(encoded[1] / 32767.0f, -1.0f);
+            float z = 1.0f - std::fabs(x) - std::fabs(y);
+            float t = std::max(-z, 0.0f);
+            x += x >= 0.0f ? -t : t;
+            y += y >= 0.0f ? -t : t;
+            return Math::Vector3(x, y, z).Normalized();
+        }
+
+        Math::Vector3 VertexPacker::DecodePosition(const uint16_t position[4], const VertexQuantization& quantization)
+        {
+            return Math::Vector3(
+                position[0] / 65535.0f * quantization.scale.x + quantization.bias.x,
+                position[1] / 65535.0f * quantization.scale.y + quantization.bias.y,
+                position[2] / 65535.0f * quantization.scale.z + quantization.bias.z);
+        }
+
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "Vertex.h"
+#include "../Math/Geometry/AABB.h"
+#include <cstdint>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Rendering {
+
+        // GPU vertex layouts. Meshes are imported as full-precision Vertex and packed per mesh at upload;
+        // unskinned meshes drop the bone attributes entirely.
+        enum class VertexLayout {
+            Static,     // StaticVertex, 16 bytes
+            Skinned     // SkinnedVertex, 28 bytes
+        };
+
+        struct StaticVertex {
+            uint16_t position[4];       // location 0, unorm16 in the mesh bounds (w unused)
+            int16_t normal[2];          // location 1, snorm16 octahedral
+            uint16_t texCoords[2];      // location 2, half float
+        };
+
+        struct SkinnedVertex {
+            uint16_t position[4];
+            int16_t normal[2];
+            uint16_t texCoords[2];
+            uint8_t boneIndices[MAX_BONE_INFLUENCE];    // location 3
+            uint16_t boneWeights[MAX_BONE_INFLUENCE];   // location 4, unorm16
+        };
+
+        // Positions decode as unorm * scale + bias (uPositionScale / uPositionBias in the shaders)
+        struct VertexQuantization {
+            Math::Vector3 scale;
+            Math::Vector3 bias;
+        };
+
+        class VertexPacker {
+        public:
+            // Bone indices are stored as bytes
+            static constexpr int MAX_PACKED_BONES = 256;
+
+            static size_t GetStride(VertexLayout layout);
+
+            static VertexQuantization ComputeQuantization(const Math::AABB& bounds);
+
+            // Packs vertices into layout; the result is GetStride(layout) bytes per vertex
+            static std::vector<uint8_t> Pack(const std::vector<Vertex>& vertices, VertexLayout layout,
+                const VertexQuantization& quantization);
+
+            static uint16_t FloatToHalf(float value);
+            static float HalfToFloat(uint16_t value);
+            static void EncodeOctahedral(const Math::Vector3& normal, int16_t out[2]);
+            static Math::Vector3 DecodeOctahedral(const int16_t encoded[2]);
+            static Math::Vector3 DecodePosition(const uint16_t position[4], const VertexQuantization& quantization);
+        };
+
+    }
+}
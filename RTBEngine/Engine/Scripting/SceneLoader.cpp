@@ -9,6 +9,7 @@
 #include "../ECS/RigidBodyComponent.h"
 #include "../ECS/BoxColliderComponent.h"
 #include "../Core/ResourceManager.h"
+#include "../Core/Profiler.h"
 #include "../Rendering/Lighting/DirectionalLight.h"
 #include "../Rendering/Lighting/PointLight.h"
 #include "../Rendering/Lighting/SpotLight.h"
@@ -27,6 +28,7 @@
 
 #include <lua.hpp>
 #include <LuaBridge/LuaBridge.h>
+#include <algorithm>
 #include <cstdio>
 #include "../RTBEngine.h"
 
@@ -124,6 +126,18 @@ namespace RTBEngine {
             return result;
         }
 
+        // Import-time mesh optimization for the model a component loads: optimizeMesh toggles it,
+        // overdrawThreshold bounds the ACMR cost of the overdraw pass
+        static Rendering::MeshOptimizeOptions ReadMeshOptimizeOptions(lua_State* L, int tableIndex) {
+            Rendering::MeshOptimizeOptions options;
+            options.enabled = ReadOptionalBool(L, tableIndex, "optimizeMesh", options.enabled);
+            options.overdrawThreshold = ReadOptionalFloat(L, tableIndex, "overdrawThreshold", options.overdrawThreshold);
+            options.lodLevels = static_cast<uint32_t>(std::max(0, ReadOptionalInt(L, tableIndex, "lodLevels",
+                static_cast<int>(options.lodLevels))));
+            options.lodScreenSize = ReadOptionalFloat(L, tableIndex, "lodScreenSize", options.lodScreenSize);
+            return options;
+        }
+
         #pragma endregion
 
         #pragma region Component Configurators
@@ -196,6 +210,18 @@ namespace RTBEngine {
         static void ConfigureMeshRenderer(lua_State* L, int tableIndex, ECS::MeshRenderer* comp) {
             Core::ResourceManager& resources = Core::ResourceManager::GetInstance();
 
+            comp->isStatic = ReadOptionalBool(L, tableIndex, "isStatic", false);
+            comp->lodBias = ReadOptionalFloat(L, tableIndex, "lodBias", comp->lodBias);
+            comp->shadowLodOffset = ReadOptionalInt(L, tableIndex, "shadowLodOffset", comp->shadowLodOffset);
+            comp->isOccluder = ReadOptionalBool(L, tableIndex, "occluder", false);
+
+            // occluderMesh (string path) - simplified stand-in for the occlusion buffer
+            std::string occluderPath = ReadOptionalString(L, tableIndex, "occluderMesh", "");
+            if (!occluderPath.empty()) {
+                comp->occluderMesh = resources.LoadModel(occluderPath);
+                comp->isOccluder = comp->occluderMesh != nullptr || comp->isOccluder;
+            }
+
             // shader (string name, default "basic") - load first so materials can use it
             std::string shaderName = ReadOptionalString(L, tableIndex, "shader", "basic");
             Rendering::Shader* shader = resources.GetShader(shaderName);
@@ -206,7 +232,8 @@ namespace RTBEngine {
             // model (string path) - loads model with embedded materials/textures
             std::string modelPath = ReadOptionalString(L, tableIndex, "model", "");
             if (!modelPath.empty()) {
-                Rendering::ModelData modelData = Rendering::ModelLoader::LoadModelWithAnimations(modelPath);
+                Rendering::ModelData modelData = Rendering::ModelLoader::LoadModelWithAnimations(modelPath,
+                    ReadMeshOptimizeOptions(L, tableIndex));
 
                 if (!modelData.meshes.empty()) {
                     comp->SetMeshes(modelData.meshes);
@@ -241,23 +268,20 @@ namespace RTBEngine {
                             if (matIdx >= 0 && matIdx < static_cast<int>(modelData.materials.size())) {
                                 const Rendering::LoadedMaterial& loadedMat = modelData.materials[matIdx];
 
-                                Rendering::Material* mat = new Rendering::Material(shader);
-                                mat->SetDiffuseColor(loadedMat.diffuseColor);
-
                                 // Apply embedded texture if available
+                                Rendering::Texture* texture = nullptr;
                                 if (loadedMat.embeddedTextureIndex >= 0 &&
                                     loadedMat.embeddedTextureIndex < static_cast<int>(embeddedTextures.size()) &&
                                     embeddedTextures[loadedMat.embeddedTextureIndex]) {
-                                    mat->SetTexture(embeddedTextures[loadedMat.embeddedTextureIndex]);
+                                    texture = embeddedTextures[loadedMat.embeddedTextureIndex];
                                 }
                                 else if (!loadedMat.diffuseTexturePath.empty()) {
-                                    Rendering::Texture* tex = resources.LoadTexture(loadedMat.diffuseTexturePath);
-                                    if (tex) {
-                                        mat->SetTexture(tex);
-                                    }
+                                    texture = resources.LoadTexture(loadedMat.diffuseTexturePath);
                                 }
 
-                                meshMats.push_back(mat);
+                                // Identical materials are shared so equal meshes can be instanced together
+                                meshMats.push_back(resources.GetSharedMaterial(shader, texture,
+                                    Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f), loadedMat.diffuseColor));
                             } else {
                                 meshMats.push_back(nullptr);
                             }
@@ -270,7 +294,8 @@ namespace RTBEngine {
                 // mesh (string path) - simple mesh loading without materials
                 std::string meshPath = ReadOptionalString(L, tableIndex, "mesh", "");
                 if (!meshPath.empty()) {
-                    const std::vector<Rendering::Mesh*>& meshes = resources.LoadModelMeshes(meshPath);
+                    const std::vector<Rendering::Mesh*>& meshes = resources.LoadModelMeshes(meshPath,
+                        ReadMeshOptimizeOptions(L, tableIndex));
                     if (!meshes.empty()) {
                         comp->SetMeshes(meshes);
                     }
@@ -300,6 +325,9 @@ namespace RTBEngine {
 
                 bool castShadows = ReadOptionalBool(L, tableIndex, "castShadows", false);
                 if (castShadows) {
+                    dirLight->SetShadowCascadeCount(ReadOptionalInt(L, tableIndex, "shadowCascadeCount", Rendering::MAX_SHADOW_CASCADES));
+                    dirLight->SetShadowDistance(ReadOptionalFloat(L, tableIndex, "shadowDistance", 100.0f));
+                    dirLight->SetCascadeSplitLambda(ReadOptionalFloat(L, tableIndex, "cascadeSplitLambda", 0.75f));
                     dirLight->SetCastShadows(true);
 
                     int shadowMapResolution = ReadOptionalInt(L, tableIndex, "shadowMapResolution", 1024);
@@ -420,7 +448,8 @@ namespace RTBEngine {
             // model (string path) - Load model with animations
             std::string modelPath = ReadOptionalString(L, tableIndex, "model", "");
             if (!modelPath.empty()) {
-                Rendering::ModelData modelData = Rendering::ModelLoader::LoadModelWithAnimations(modelPath);
+                Rendering::ModelData modelData = Rendering::ModelLoader::LoadModelWithAnimations(modelPath,
+                    ReadMeshOptimizeOptions(L, tableIndex));
 
                 if (modelData.skeleton) {
                     comp->SetSkeleton(modelData.skeleton);
@@ -469,25 +498,21 @@ namespace RTBEngine {
                                     if (matIdx >= 0 && matIdx < static_cast<int>(modelData.materials.size())) {
                                         const Rendering::LoadedMaterial& loadedMat = modelData.materials[matIdx];
 
-                                        // Create new material
-                                        Rendering::Material* mat = new Rendering::Material(shader);
-                                        mat->SetDiffuseColor(loadedMat.diffuseColor);
-
                                         // Try embedded texture first, then external file
+                                        Core::ResourceManager& resources = Core::ResourceManager::GetInstance();
+                                        Rendering::Texture* texture = nullptr;
                                         if (loadedMat.embeddedTextureIndex >= 0 &&
                                             loadedMat.embeddedTextureIndex < static_cast<int>(embeddedTextures.size()) &&
                                             embeddedTextures[loadedMat.embeddedTextureIndex]) {
-                                            mat->SetTexture(embeddedTextures[loadedMat.embeddedTextureIndex]);
+                                            texture = embeddedTextures[loadedMat.embeddedTextureIndex];
                                         }
                                         else if (!loadedMat.diffuseTexturePath.empty()) {
-                                            Core::ResourceManager& resources = Core::ResourceManager::GetInstance();
-                                            Rendering::Texture* tex = resources.LoadTexture(loadedMat.diffuseTexturePath);
-                                            if (tex) {
-                                                mat->SetTexture(tex);
-                                            }
+                                            texture = resources.LoadTexture(loadedMat.diffuseTexturePath);
                                         }
 
-                                        meshMats.push_back(mat);
+                                        // Shared material, so identical meshes can be instanced together
+                                        meshMats.push_back(resources.GetSharedMaterial(shader, texture,
+                                            Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f), loadedMat.diffuseColor));
                                     } else {
                                         meshMats.push_back(nullptr);  // Use default material
                                     }
@@ -555,6 +580,8 @@ namespace RTBEngine {
         }
 
         ECS::Scene* SceneLoader::LoadScene(const std::string& filePath) {
+            RTB_PROFILE_SCOPE("SceneLoader::LoadScene");
+
             // Create Lua state
             lua_State* L = luaL_newstate();
             luaL_openlibs(L);
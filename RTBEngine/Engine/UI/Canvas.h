@@ -38,6 +38,8 @@ namespace RTBEngine {
 			virtual void OnUpdate(float deltaTime) override;
 			virtual void OnDestroy() override;
 
+			RTB_COMPONENT_TYPE(Canvas)
+
 		private:
 			void CollectUIElements();
 			void UpdateRectTransforms(const Math::Vector2& screenSize);
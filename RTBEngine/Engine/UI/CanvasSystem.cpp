@@ -10,6 +10,8 @@
 #include "../ECS/Scene.h"
 #include "../ECS/GameObject.h"
 #include "../Core/ResourceManager.h"
+#include "../Core/Profiler.h"
+#include "../Rendering/GLStateCache.h"
 #include "../Input/InputManager.h"
 #include "../Input/MouseButton.h"
 #include <imgui.h>
@@ -86,10 +88,8 @@ namespace RTBEngine {
 			SDL_GetWindowSize(window, &width, &height);
 			screenSize = Math::Vector2(static_cast<float>(width), static_cast<float>(height));
 
-			for (const auto& objPtr : scene->GetGameObjects()) {
-				ECS::GameObject* obj = objPtr.get();
-				Canvas* canvas = obj->GetComponent<Canvas>();
-				if (canvas && canvas->IsEnabled() && obj->IsActive()) {
+			for (Canvas* canvas : scene->View<Canvas>()) {
+				if (canvas->IsEnabled() && canvas->GetOwner()->IsActive()) {
 					activeCanvases.push_back(canvas);
 				}
 			}
@@ -103,6 +103,8 @@ namespace RTBEngine {
 		void CanvasSystem::RenderAll() {
 			if (!isInitialized) return;
 
+			RTB_PROFILE_SCOPE("CanvasSystem::RenderAll");
+
 			ImGui_ImplOpenGL3_NewFrame();
 			ImGui_ImplSDL2_NewFrame();
 			ImGui::NewFrame();
@@ -113,6 +115,9 @@ namespace RTBEngine {
 
 			ImGui::Render();
 			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+			// The ImGui backend sets and restores GL state with raw calls the cache never saw
+			Rendering::GLStateCache::GetInstance().Invalidate();
 		}
 
 		void CanvasSystem::RenderCanvasesOnly(const Math::Vector2* customScreenSize) {
@@ -26,6 +26,8 @@ namespace RTBEngine {
 
 			virtual void Render() = 0;
 
+			RTB_COMPONENT_BASE_TYPE(UIElement)
+
 		protected:
 			std::unique_ptr<RectTransform> rectTransform;
 		};
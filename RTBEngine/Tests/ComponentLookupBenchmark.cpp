@@ -0,0 +1,113 @@
+#include "TestFramework.h"
+#include "../Engine/ECS/GameObject.h"
+#include <memory>
+#include <vector>
+
+using namespace RTBEngine;
+
+namespace {
+    // Distinct component types, each with its own type id like the built-in components
+    template<int Index>
+    class LookupComponent : public ECS::Component {
+        RTB_COMPONENT_TYPE(LookupComponent)
+    public:
+        const char* GetTypeName() const override { return "LookupComponent"; }
+        int value = Index;
+    };
+
+    using First = LookupComponent<0>;
+    using Middle = LookupComponent<3>;
+    using Last = LookupComponent<7>;
+    using Missing = LookupComponent<8>;
+
+    void AddLookupComponents(ECS::GameObject& gameObject) {
+        gameObject.AddComponent(new LookupComponent<0>());
+        gameObject.AddComponent(new LookupComponent<1>());
+        gameObject.AddComponent(new LookupComponent<2>());
+        gameObject.AddComponent(new LookupComponent<3>());
+        gameObject.AddComponent(new LookupComponent<4>());
+        gameObject.AddComponent(new LookupComponent<5>());
+        gameObject.AddComponent(new LookupComponent<6>());
+        gameObject.AddComponent(new LookupComponent<7>());
+    }
+
+    // GetComponent<T> before type ids: the first component dynamic_cast accepts
+    template<typename T>
+    T* FindByDynamicCast(const ECS::GameObject& gameObject) {
+        for (const auto& component : gameObject.GetComponents()) {
+            if (T* cast = dynamic_cast<T*>(component.get())) return cast;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    void CompareLookups(const std::vector<std::unique_ptr<ECS::GameObject>>& gameObjects, const char* label) {
+        const int PASSES = 20;
+        const int RUNS = 5;
+        volatile int sink = 0;
+
+        double slotMs = Tests::MeasureBestMs(RUNS, [&]() {
+            int sum = 0;
+            for (int pass = 0; pass < PASSES; ++pass) {
+                for (const auto& gameObject : gameObjects) {
+                    T* component = gameObject->GetComponent<T>();
+                    sum += component ? component->value : -1;
+                }
+            }
+            sink = sink + sum;
+        });
+
+        double castMs = Tests::MeasureBestMs(RUNS, [&]() {
+            int sum = 0;
+            for (int pass = 0; pass < PASSES; ++pass) {
+                for (const auto& gameObject : gameObjects) {
+                    T* component = FindByDynamicCast<T>(*gameObject);
+                    sum += component ? component->value : -1;
+                }
+            }
+            sink = sink + sum;
+        });
+
+        double lookups = static_cast<double>(PASSES) * gameObjects.size();
+        std::printf("    %-8s %10.2f %14.2f %8.1fx\n", label,
+            slotMs * 1.0e6 / lookups, castMs * 1.0e6 / lookups, castMs / slotMs);
+    }
+}
+
+RTB_TEST(ComponentLookup_MatchesDynamicCastScan)
+{
+    ECS::GameObject gameObject("Lookup");
+    AddLookupComponents(gameObject);
+
+    RTB_CHECK(gameObject.GetComponent<First>() == FindByDynamicCast<First>(gameObject));
+    RTB_CHECK(gameObject.GetComponent<Middle>() == FindByDynamicCast<Middle>(gameObject));
+    RTB_CHECK(gameObject.GetComponent<Last>() == FindByDynamicCast<Last>(gameObject));
+    RTB_CHECK(gameObject.GetComponent<Last>()->value == 7);
+    RTB_CHECK(gameObject.GetComponent<Missing>() == nullptr);
+    RTB_CHECK(FindByDynamicCast<Missing>(gameObject) == nullptr);
+
+    gameObject.RemoveComponent(gameObject.GetComponent<Middle>());
+    RTB_CHECK(gameObject.GetComponent<Middle>() == nullptr);
+    RTB_CHECK(gameObject.GetComponent<Last>() == FindByDynamicCast<Last>(gameObject));
+}
+
+// GetComponent<T> through the type id slots against the old dynamic_cast scan, over 10k objects
+// with eight components each. The scan cost grows with the component's position in the list.
+RTB_BENCHMARK(ComponentLookup_SlotsVersusDynamicCast)
+{
+    const size_t OBJECT_COUNT = 10000;
+
+    std::vector<std::unique_ptr<ECS::GameObject>> gameObjects;
+    gameObjects.reserve(OBJECT_COUNT);
+    for (size_t i = 0; i < OBJECT_COUNT; ++i) {
+        gameObjects.push_back(std::make_unique<ECS::GameObject>("Object"));
+        AddLookupComponents(*gameObjects.back());
+    }
+
+    std::printf("    %zu objects, 8 components each, ns per lookup\n", OBJECT_COUNT);
+    std::printf("    %-8s %10s %14s %9s\n", "type", "slots", "dynamic_cast", "ratio");
+    CompareLookups<First>(gameObjects, "first");
+    CompareLookups<Middle>(gameObjects, "middle");
+    CompareLookups<Last>(gameObjects, "last");
+    CompareLookups<Missing>(gameObjects, "missing");
+}
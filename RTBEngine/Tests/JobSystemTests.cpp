@@ -0,0 +1,216 @@
+#include "TestFramework.h"
+#include "../Engine/Core/JobSystem.h"
+#include "../Engine/Core/Application.h"
+#include "../Engine/Math/Math.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace RTBEngine;
+
+namespace {
+    const int TEST_WORKERS = 3;
+
+    // Every index in [0, count) visited exactly once, for several grain sizes
+    void CheckParallelForCoverage(size_t count) {
+        const size_t grains[] = { 0, 1, 7, 64, count, count + 10 };
+        for (size_t grain : grains) {
+            std::vector<std::atomic<int>> visits(count);
+            std::atomic<size_t> ranges{ 0 };
+            Core::JobSystem::GetInstance().ParallelFor(count, grain, [&](size_t begin, size_t end) {
+                RTB_CHECK(begin < end && end <= visits.size());
+                for (size_t i = begin; i < end; ++i) visits[i]++;
+                ranges++;
+            });
+
+            bool exact = std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v.load() == 1; });
+            RTB_CHECK(exact);
+            if (grain > 0) {
+                RTB_CHECK(ranges.load() == (count + grain - 1) / grain);
+            }
+        }
+    }
+}
+
+RTB_TEST(JobSystem_ParallelForCoversEveryIndexOnce)
+{
+    Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+    jobs.Initialize(TEST_WORKERS);
+
+    CheckParallelForCoverage(1);
+    CheckParallelForCoverage(1000);
+    CheckParallelForCoverage(10007);
+
+    int calls = 0;
+    jobs.ParallelFor(0, 16, [&](size_t, size_t) { calls++; });
+    RTB_CHECK(calls == 0);
+
+    jobs.Shutdown();
+}
+
+RTB_TEST(JobSystem_CountersAndContinuationsKeepOrder)
+{
+    Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+    jobs.Initialize(TEST_WORKERS);
+
+    // Three stages: each stage's jobs may only start once every job of the previous stage finished
+    const int JOBS_PER_STAGE = 32;
+    std::atomic<int> finished[3] = { {0}, {0}, {0} };
+    std::atomic<int> earlyStarts{ 0 };
+    Core::JobCounter stages[3];
+
+    for (int stage = 0; stage < 3; ++stage) {
+        Core::JobCounter* dependency = stage > 0 ? &stages[stage - 1] : nullptr;
+        for (int i = 0; i < JOBS_PER_STAGE; ++i) {
+            jobs.Run([&, stage]() {
+                if (stage > 0 && finished[stage - 1].load() != JOBS_PER_STAGE) earlyStarts++;
+                std::this_thread::yield();
+                finished[stage]++;
+            }, &stages[stage], dependency);
+        }
+    }
+
+    jobs.Wait(stages[2]);
+    RTB_CHECK(stages[0].IsDone() && stages[1].IsDone() && stages[2].IsDone());
+    RTB_CHECK(finished[0].load() == JOBS_PER_STAGE);
+    RTB_CHECK(finished[1].load() == JOBS_PER_STAGE);
+    RTB_CHECK(finished[2].load() == JOBS_PER_STAGE);
+    RTB_CHECK(earlyStarts.load() == 0);
+
+    // A dependency that is already done releases the job straight away
+    Core::JobCounter late;
+    std::atomic<bool> ran{ false };
+    jobs.Run([&]() { ran = true; }, &late, &stages[0]);
+    jobs.Wait(late);
+    RTB_CHECK(ran.load());
+    RTB_CHECK(late.GetPending() == 0);
+
+    jobs.Shutdown();
+}
+
+RTB_TEST(JobSystem_WaitInsideJobDoesNotDeadlock)
+{
+    Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+    jobs.Initialize(TEST_WORKERS);
+
+    // More waiting jobs than threads: waiters must run queued work instead of blocking a worker
+    const int OUTER_JOBS = TEST_WORKERS * 4;
+    const int INNER_JOBS = 16;
+    std::atomic<int> innerDone{ 0 };
+    std::atomic<int> outerSawAllInner{ 0 };
+    Core::JobCounter outer;
+
+    for (int i = 0; i < OUTER_JOBS; ++i) {
+        jobs.Run([&]() {
+            Core::JobCounter inner;
+            std::atomic<int> mine{ 0 };
+            for (int j = 0; j < INNER_JOBS; ++j) {
+                jobs.Run([&]() { mine++; innerDone++; }, &inner);
+            }
+            jobs.Wait(inner);
+            if (mine.load() == INNER_JOBS) outerSawAllInner++;
+        }, &outer);
+    }
+
+    jobs.Wait(outer);
+    RTB_CHECK(innerDone.load() == OUTER_JOBS * INNER_JOBS);
+    RTB_CHECK(outerSawAllInner.load() == OUTER_JOBS);
+
+    jobs.Shutdown();
+}
+
+RTB_TEST(JobSystem_ZeroWorkersRunsInline)
+{
+    Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+    jobs.Initialize(0);
+    RTB_CHECK(jobs.GetWorkerCount() == 0);
+
+    std::thread::id caller = std::this_thread::get_id();
+
+    // Run executes before returning, on the calling thread
+    Core::JobCounter counter;
+    bool ran = false;
+    bool onCaller = false;
+    jobs.Run([&]() { ran = true; onCaller = std::this_thread::get_id() == caller; }, &counter);
+    RTB_CHECK(ran);
+    RTB_CHECK(onCaller);
+    RTB_CHECK(counter.IsDone());
+
+    // Continuations too, once their dependency is done
+    Core::JobCounter first, second;
+    int order = 0, firstOrder = -1, secondOrder = -1;
+    jobs.Run([&]() { firstOrder = order++; }, &first);
+    jobs.Run([&]() { secondOrder = order++; }, &second, &first);
+    jobs.Wait(second);
+    RTB_CHECK(firstOrder == 0 && secondOrder == 1);
+
+    size_t calls = 0;
+    size_t covered = 0;
+    jobs.ParallelFor(1000, 10, [&](size_t begin, size_t end) { calls++; covered += end - begin; });
+    RTB_CHECK(calls == 1);
+    RTB_CHECK(covered == 1000);
+
+    jobs.Shutdown();
+}
+
+// Synthetic per-object work (a TRS matrix and a transformed point each) swept over the worker count.
+// With --scene <path>, also runs that scene headless with parallelSceneUpdate for every worker count
+// (--frames, default 300) and reports the frame timing statistics.
+RTB_BENCHMARK(JobSystem_WorkerScaling)
+{
+    const size_t OBJECT_COUNT = 200000;
+    const int RUNS = 5;
+    const int maxWorkers = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+
+    std::vector<Math::Vector4> results(OBJECT_COUNT);
+    auto work = [&results](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float t = static_cast<float>(i);
+            Math::Matrix4 world = Math::Matrix4::Translate(Math::Vector3(t, t * 0.5f, -t))
+                * Math::Matrix4::RotateY(t * 0.001f)
+                * Math::Matrix4::Scale(Math::Vector3(1.0f, 2.0f, 1.0f));
+            results[i] = world * Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+        }
+    };
+
+    Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+    double baselineMs = 0.0;
+    std::printf("    %zu objects, best of %d\n", OBJECT_COUNT, RUNS);
+    std::printf("    workers      ms   speedup\n");
+    for (int workers = 0; workers <= maxWorkers; ++workers) {
+        jobs.Initialize(workers);
+        double ms = Tests::MeasureBestMs(RUNS, [&]() { jobs.ParallelFor(OBJECT_COUNT, 0, work); });
+        jobs.Shutdown();
+
+        if (workers == 0) baselineMs = ms;
+        std::printf("    %7d %7.2f %8.2fx\n", workers, ms, baselineMs / ms);
+    }
+
+    std::string scenePath = Tests::TestRegistry::GetOption("--scene");
+    if (scenePath.empty()) return;
+
+    int frames = std::max(std::atoi(Tests::TestRegistry::GetOption("--frames", "300").c_str()), 1);
+    std::printf("    headless %s, %d frames\n", scenePath.c_str(), frames);
+    std::printf("    workers  avg ms  p95 ms  update ms\n");
+    for (int workers = 0; workers <= maxWorkers; ++workers) {
+        Core::ApplicationConfig config;
+        config.headless.enabled = true;
+        config.headless.frameCount = frames;
+        config.jobs.workerThreads = workers;
+        config.jobs.parallelSceneUpdate = true;
+        config.initialScenePath = scenePath;
+
+        Core::Application app(config);
+        if (!app.Initialize()) {
+            std::printf("    failed to start the headless application\n");
+            RTB_CHECK(false);
+            return;
+        }
+        app.Run();
+
+        const Core::FrameTimingStats& stats = app.GetFrameTimingStats();
+        std::printf("    %7d %7.3f %7.3f %10.3f\n", workers, stats.averageMs, stats.p95Ms, stats.averageUpdateMs);
+    }
+}
@@ -0,0 +1,82 @@
+#include "TestFramework.h"
+#include "../Engine/ECS/GameObject.h"
+#include "../Engine/ECS/MeshRenderer.h"
+#include "../Engine/Core/ResourceManager.h"
+#include "../Engine/Rendering/GraphicsContext.h"
+#include <memory>
+#include <vector>
+
+using namespace RTBEngine;
+
+namespace {
+    // Unit quad; headless meshes keep the CPU copy and never touch the arena
+    std::unique_ptr<Rendering::Mesh> MakeQuad() {
+        std::vector<Rendering::Vertex> vertices(4);
+        vertices[0].position = Math::Vector3(-0.5f, -0.5f, 0.0f);
+        vertices[1].position = Math::Vector3(0.5f, -0.5f, 0.0f);
+        vertices[2].position = Math::Vector3(0.5f, 0.5f, 0.0f);
+        vertices[3].position = Math::Vector3(-0.5f, 0.5f, 0.0f);
+        return std::make_unique<Rendering::Mesh>(vertices, std::vector<unsigned int>{ 0, 1, 2, 0, 2, 3 });
+    }
+
+    // Set up the way SceneLoader configures a { mesh = ..., shader = ... } MeshRenderer
+    ECS::MeshRenderer* AddRenderer(ECS::GameObject& gameObject, Rendering::Mesh* mesh, Rendering::Shader* shader) {
+        ECS::MeshRenderer* renderer = new ECS::MeshRenderer();
+        gameObject.AddComponent(renderer);
+        renderer->SetShader(shader);
+        renderer->SetMeshes({ mesh });
+        return renderer;
+    }
+
+    void SubmitAll(Rendering::RenderQueue& queue, const std::vector<ECS::MeshRenderer*>& renderers) {
+        Rendering::Camera camera;
+        queue.Clear();
+        for (ECS::MeshRenderer* renderer : renderers) {
+            renderer->Submit(queue, camera, renderer->GetWorldBounds());
+        }
+        queue.Sort();
+    }
+}
+
+RTB_TEST(MaterialSharing_IdenticalRenderersInstanceTogether) {
+    Rendering::GraphicsContext::SetAvailable(false);
+    {
+        std::unique_ptr<Rendering::Mesh> quad = MakeQuad();
+        Rendering::Shader shader;
+
+        ECS::GameObject first("First");
+        ECS::GameObject second("Second");
+        first.GetTransform().SetPosition(Math::Vector3(-2.0f, 0.0f, -5.0f));
+        second.GetTransform().SetPosition(Math::Vector3(2.0f, 0.0f, -8.0f));
+        ECS::MeshRenderer* firstRenderer = AddRenderer(first, quad.get(), &shader);
+        ECS::MeshRenderer* secondRenderer = AddRenderer(second, quad.get(), &shader);
+        RTB_CHECK(firstRenderer->GetMaterial() == secondRenderer->GetMaterial());
+
+        // A frame without edits keeps the shared material
+        firstRenderer->OnUpdate(0.0f);
+        secondRenderer->OnUpdate(0.0f);
+        RTB_CHECK(firstRenderer->GetMaterial() == secondRenderer->GetMaterial());
+
+        Rendering::RenderQueue queue;
+        SubmitAll(queue, { firstRenderer, secondRenderer });
+        RTB_CHECK(queue.GetSize() == 2);
+        // Same key apart from the 14 depth bits
+        RTB_CHECK(queue.GetItems()[0].sortKey >> 14 == queue.GetItems()[1].sortKey >> 14);
+        RTB_CHECK(queue.FindInstanceRun(0, true) == 2);
+
+        // Recoloring one renderer copies its material and leaves the other one alone
+        Rendering::Material* shared = firstRenderer->GetMaterial();
+        secondRenderer->colorRef = Math::Vector4(1.0f, 0.0f, 0.0f, 1.0f);
+        secondRenderer->OnUpdate(0.0f);
+        RTB_CHECK(secondRenderer->GetMaterial() != shared);
+        RTB_CHECK(secondRenderer->GetMaterial()->GetColor() == Math::Vector4(1.0f, 0.0f, 0.0f, 1.0f));
+        RTB_CHECK(shared->GetColor() == Math::Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+        RTB_CHECK(firstRenderer->GetMaterial() == shared);
+
+        SubmitAll(queue, { firstRenderer, secondRenderer });
+        RTB_CHECK(queue.FindInstanceRun(0, true) == 1);
+    }
+    // The cache is keyed on the stack shader above
+    Core::ResourceManager::GetInstance().Clear();
+    Rendering::GraphicsContext::SetAvailable(true);
+}
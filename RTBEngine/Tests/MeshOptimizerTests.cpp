@@ -0,0 +1,136 @@
+#include "TestFramework.h"
+#include "../Engine/Rendering/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace RTBEngine;
+using Rendering::Vertex;
+using Rendering::MeshOptimizer;
+
+namespace {
+    const int GRID_SIZE = 32;   // quads per side
+    const uint32_t CACHE_SIZE = 16;
+
+    Vertex MakeGridVertex(int x, int z) {
+        Vertex vertex;
+        vertex.position = Math::Vector3(static_cast<float>(x), 0.0f, static_cast<float>(z));
+        vertex.normal = Math::Vector3(0.0f, 1.0f, 0.0f);
+        vertex.texCoords = Math::Vector2(static_cast<float>(x) / GRID_SIZE, static_cast<float>(z) / GRID_SIZE);
+        return vertex;
+    }
+
+    // Flat grid as an unindexed importer would hand it over: three fresh vertices per triangle,
+    // triangles in a fixed pseudo-random order (own LCG so every platform gets the same mesh)
+    void BuildShuffledGrid(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+        std::vector<std::array<int, 6>> triangles;
+        for (int z = 0; z < GRID_SIZE; ++z) {
+            for (int x = 0; x < GRID_SIZE; ++x) {
+                triangles.push_back({ x, z, x, z + 1, x + 1, z + 1 });
+                triangles.push_back({ x, z, x + 1, z + 1, x + 1, z });
+            }
+        }
+
+        uint32_t state = 12345u;
+        for (size_t i = triangles.size() - 1; i > 0; --i) {
+            state = state * 1664525u + 1013904223u;
+            std::swap(triangles[i], triangles[state % (i + 1)]);
+        }
+
+        vertices.clear();
+        indices.clear();
+        for (const auto& triangle : triangles) {
+            for (int corner = 0; corner < 3; ++corner) {
+                indices.push_back(static_cast<unsigned int>(vertices.size()));
+                vertices.push_back(MakeGridVertex(triangle[corner * 2], triangle[corner * 2 + 1]));
+            }
+        }
+    }
+
+    // Triangles as position triples, each rotated to start at its smallest corner (winding kept), sorted
+    using TriangleKey = std::array<float, 9>;
+    std::vector<TriangleKey> CanonicalTriangles(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+        std::vector<TriangleKey> keys;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            std::array<std::array<float, 3>, 3> corners;
+            for (int c = 0; c < 3; ++c) {
+                const Math::Vector3& p = vertices[indices[i + c]].position;
+                corners[c] = { p.x, p.y, p.z };
+            }
+            std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+            TriangleKey key;
+            for (int c = 0; c < 3; ++c) {
+                std::copy(corners[c].begin(), corners[c].end(), key.begin() + c * 3);
+            }
+            keys.push_back(key);
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+}
+
+RTB_TEST(MeshOptimizer_GridWeldsAndReorders)
+{
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    BuildShuffledGrid(vertices, indices);
+    const std::vector<TriangleKey> trianglesBefore = CanonicalTriangles(vertices, indices);
+
+    // Welding alone leaves the shuffled order: the reference for what reordering gains
+    std::vector<Vertex> weldedVertices = vertices;
+    std::vector<unsigned int> weldedIndices = indices;
+    MeshOptimizer::WeldVertices(weldedVertices, weldedIndices);
+    float weldedACMR = MeshOptimizer::ComputeACMR(weldedIndices, weldedVertices.size(), CACHE_SIZE);
+
+    Rendering::MeshOptimizeOptions options;
+    options.cacheSize = CACHE_SIZE;
+    Rendering::MeshOptimizeStats stats = MeshOptimizer::Optimize(vertices, indices, options);
+
+    const uint32_t triangleCount = GRID_SIZE * GRID_SIZE * 2;
+    RTB_CHECK(stats.verticesBefore == triangleCount * 3);
+    RTB_CHECK(stats.verticesAfter == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+    RTB_CHECK(vertices.size() == stats.verticesAfter);
+    RTB_CHECK(indices.size() == triangleCount * 3);
+
+    // Unwelded, every corner is a miss
+    RTB_CHECK(stats.acmrBefore == 3.0f);
+    RTB_CHECK(weldedACMR > 1.5f);
+    // A regular grid with a 16-entry FIFO reorders to well under one miss per triangle
+    RTB_CHECK(stats.acmrAfter < 0.8f);
+    RTB_CHECK(stats.acmrAfter < weldedACMR * 0.5f);
+    RTB_CHECK(stats.acmrAfter == MeshOptimizer::ComputeACMR(indices, vertices.size(), CACHE_SIZE));
+
+    // Same triangles with the same winding, only reordered
+    RTB_CHECK(CanonicalTriangles(vertices, indices) == trianglesBefore);
+
+    // Vertex fetch order: first use order, so indices never jump past the next unused vertex
+    unsigned int nextNew = 0;
+    bool firstUseOrder = true;
+    for (unsigned int index : indices) {
+        if (index > nextNew) firstUseOrder = false;
+        if (index == nextNew) nextNew++;
+    }
+    RTB_CHECK(firstUseOrder);
+}
+
+RTB_TEST(MeshOptimizer_IsDeterministic)
+{
+    std::vector<Vertex> verticesA, verticesB;
+    std::vector<unsigned int> indicesA, indicesB;
+    BuildShuffledGrid(verticesA, indicesA);
+    BuildShuffledGrid(verticesB, indicesB);
+
+    Rendering::MeshOptimizeOptions options;
+    MeshOptimizer::Optimize(verticesA, indicesA, options);
+    MeshOptimizer::Optimize(verticesB, indicesB, options);
+
+    RTB_CHECK(indicesA == indicesB);
+    bool sameVertices = verticesA.size() == verticesB.size();
+    for (size_t i = 0; sameVertices && i < verticesA.size(); ++i) {
+        sameVertices = verticesA[i].position.x == verticesB[i].position.x
+            && verticesA[i].position.z == verticesB[i].position.z;
+    }
+    RTB_CHECK(sameVertices);
+}
@@ -0,0 +1,125 @@
+#include "TestFramework.h"
+#include "../Engine/Rendering/OcclusionCuller.h"
+#include "../Engine/Core/JobSystem.h"
+#include <cmath>
+
+using namespace RTBEngine;
+using Math::Vector3;
+
+namespace {
+    // Camera at the origin looking down -z, 60 degree vertical field of view, twice as wide as high
+    const float FOV = 60.0f * 3.14159265f / 180.0f;
+    const float ASPECT = 2.0f;
+    const int BUFFER_WIDTH = 256;
+    const int BUFFER_HEIGHT = 128;
+
+    Math::Matrix4 MakePerspective() {
+        return Math::Matrix4::Perspective(FOV, ASPECT, 0.1f, 100.0f);
+    }
+
+    // World x that lands on the given buffer column at the given distance in front of the camera
+    float WorldXAtScreen(float screenX, float distance) {
+        float ndc = screenX / BUFFER_WIDTH * 2.0f - 1.0f;
+        return ndc * distance * std::tan(FOV * 0.5f) * ASPECT;
+    }
+
+    // Square wall facing the camera, counter-clockwise, centred on the view axis at distance
+    void AddWall(Rendering::OcclusionCuller& culler, std::vector<Vector3>& positions, std::vector<uint32_t>& indices,
+        float halfWidth, float distance) {
+        positions = { { -halfWidth, -halfWidth, 0.0f }, { halfWidth, -halfWidth, 0.0f },
+            { halfWidth, halfWidth, 0.0f }, { -halfWidth, halfWidth, 0.0f } };
+        indices = { 0, 1, 2, 0, 2, 3 };
+        culler.AddOccluder(positions, indices, Math::Matrix4::Translate(Vector3(0.0f, 0.0f, -distance)));
+    }
+
+    void CheckWallCases(int workerCount) {
+        Core::JobSystem& jobs = Core::JobSystem::GetInstance();
+        jobs.Initialize(workerCount);
+
+        Rendering::OcclusionCuller culler;
+        culler.SetResolution(BUFFER_WIDTH, BUFFER_HEIGHT);
+        culler.BeginFrame(MakePerspective());
+
+        std::vector<Vector3> positions;
+        std::vector<uint32_t> indices;
+        AddWall(culler, positions, indices, 5.0f, 10.0f);
+        culler.Rasterize();
+
+        RTB_CHECK(culler.IsPerspective());
+        RTB_CHECK(culler.GetStats().trianglesRasterized == 2);
+
+        RTB_CHECK(!culler.IsVisible(Math::AABB(Vector3(-1, -1, -22), Vector3(1, 1, -20))));
+        RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(-1, -1, -8), Vector3(1, 1, -6))));
+        // Touching the wall: equal depth must not count as hidden
+        RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(-1, -1, -10), Vector3(1, 1, -10))));
+        // Crossing the near plane
+        RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(-1, -1, -1), Vector3(1, 1, 1))));
+        RTB_CHECK(culler.GetStats().occluded == 1);
+
+        jobs.Shutdown();
+    }
+}
+
+RTB_TEST(OcclusionCuller_WallHidesBoxBehind)
+{
+    CheckWallCases(0);
+    CheckWallCases(3);
+}
+
+RTB_TEST(OcclusionCuller_BoxPeekingPastEdgeIsVisible)
+{
+    // Wall edge 0.8 of the way across a column, so that column's centre is covered
+    const float edgeColumn = 180.8f;
+    const float wallDistance = 10.0f;
+    const float boxDistance = 20.0f;
+
+    Rendering::OcclusionCuller culler;
+    culler.SetResolution(BUFFER_WIDTH, BUFFER_HEIGHT);
+    culler.BeginFrame(MakePerspective());
+
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    AddWall(culler, positions, indices, WorldXAtScreen(edgeColumn, wallDistance), wallDistance);
+    culler.Rasterize();
+
+    // Behind the wall and a tenth of a pixel past its edge: only the covered column is touched
+    float peekX = WorldXAtScreen(edgeColumn + 0.1f, boxDistance);
+    RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(0.0f, -1.0f, -boxDistance - 2.0f), Vector3(peekX, 1.0f, -boxDistance))));
+
+    // The same box well inside the edge stays hidden
+    float insideX = WorldXAtScreen(edgeColumn - 4.0f, boxDistance);
+    RTB_CHECK(!culler.IsVisible(Math::AABB(Vector3(0.0f, -1.0f, -boxDistance - 2.0f), Vector3(insideX, 1.0f, -boxDistance))));
+}
+
+RTB_TEST(OcclusionCuller_OrthographicNeverCulls)
+{
+    Rendering::OcclusionCuller culler;
+    culler.SetResolution(BUFFER_WIDTH, BUFFER_HEIGHT);
+    culler.BeginFrame(Math::Matrix4::Orthographic(-20.0f, 20.0f, -10.0f, 10.0f, 0.1f, 100.0f));
+
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    AddWall(culler, positions, indices, 5.0f, 10.0f);
+    culler.Rasterize();
+
+    RTB_CHECK(!culler.IsPerspective());
+    // w is 1 everywhere, so depth cannot tell in front from behind
+    RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(-1, -1, -8), Vector3(1, 1, -6))));
+    RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(-1, -1, -22), Vector3(1, 1, -20))));
+    RTB_CHECK(culler.GetStats().occluded == 0);
+}
+
+RTB_TEST(OcclusionCuller_BackFacesAreSkipped)
+{
+    Rendering::OcclusionCuller culler;
+    culler.SetResolution(BUFFER_WIDTH, BUFFER_HEIGHT);
+    culler.BeginFrame(MakePerspective());
+
+    std::vector<Vector3> positions = { { -5, -5, 0 }, { 5, -5, 0 }, { 5, 5, 0 }, { -5, 5, 0 } };
+    std::vector<uint32_t> indices = { 0, 2, 1, 0, 3, 2 };
+    culler.AddOccluder(positions, indices, Math::Matrix4::Translate(Vector3(0.0f, 0.0f, -10.0f)));
+    culler.Rasterize();
+
+    RTB_CHECK(culler.GetStats().trianglesRasterized == 0);
+    RTB_CHECK(culler.IsVisible(Math::AABB(Vector3(-1, -1, -22), Vector3(1, 1, -20))));
+}
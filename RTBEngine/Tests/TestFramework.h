@@ -0,0 +1,87 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace RTBEngine {
+    namespace Tests {
+
+        // A registered test or benchmark. Tests run by default; benchmarks only with --bench.
+        struct TestCase {
+            const char* name;
+            void (*function)();
+            bool isBenchmark;
+        };
+
+        class TestRegistry {
+        public:
+            static std::vector<TestCase>& GetCases() {
+                static std::vector<TestCase> cases;
+                return cases;
+            }
+
+            // Failed checks in the running test
+            static int& GetFailureCount() {
+                static int failures = 0;
+                return failures;
+            }
+
+            static void Fail(const char* file, int line, const char* expression) {
+                std::printf("    %s(%d): check failed: %s\n", file, line, expression);
+                GetFailureCount()++;
+            }
+
+            // Command line after the runner's own flags, e.g. "--scene Assets/Scenes/TestScene.lua"
+            static std::vector<std::string>& GetArguments() {
+                static std::vector<std::string> arguments;
+                return arguments;
+            }
+
+            // Value following name on the command line, or fallback
+            static std::string GetOption(const std::string& name, const std::string& fallback = "") {
+                const std::vector<std::string>& arguments = GetArguments();
+                for (size_t i = 0; i + 1 < arguments.size(); ++i) {
+                    if (arguments[i] == name) return arguments[i + 1];
+                }
+                return fallback;
+            }
+        };
+
+        struct TestRegistrar {
+            TestRegistrar(const char* name, void (*function)(), bool isBenchmark) {
+                TestRegistry::GetCases().push_back({ name, function, isBenchmark });
+            }
+        };
+
+        // Wall-clock milliseconds of fn(), best of several runs to skip warm-up and scheduling noise
+        template<typename Fn>
+        double MeasureBestMs(int runs, Fn&& fn) {
+            double best = 0.0;
+            for (int run = 0; run < runs; ++run) {
+                auto start = std::chrono::steady_clock::now();
+                fn();
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (run == 0 || ms < best) best = ms;
+            }
+            return best;
+        }
+
+    }
+}
+
+#define RTB_TEST(Name)                                                                  \
+    static void Name();                                                                 \
+    static RTBEngine::Tests::TestRegistrar Name##Registrar(#Name, &Name, false);        \
+    static void Name()
+
+#define RTB_BENCHMARK(Name)                                                             \
+    static void Name();                                                                 \
+    static RTBEngine::Tests::TestRegistrar Name##Registrar(#Name, &Name, true);         \
+    static void Name()
+
+// Records a failure and keeps going, so one run reports every broken expectation
+#define RTB_CHECK(expression)                                                           \
+    do {                                                                                \
+        if (!(expression)) RTBEngine::Tests::TestRegistry::Fail(__FILE__, __LINE__, #expression); \
+    } while (0)
@@ -0,0 +1,52 @@
+// Test runner for the engine's CPU-side systems; nothing here needs a window or GL context.
+//   RTBEngineTests                      runs every test
+//   RTBEngineTests <filter>             runs tests whose name contains filter
+//   RTBEngineTests --bench [<filter>]   runs benchmarks instead (build Release for meaningful numbers)
+// Options after the filter are left to the tests, e.g. --scene <path> for the headless benchmark.
+#define SDL_MAIN_HANDLED
+#include "TestFramework.h"
+#include <cstring>
+
+int main(int argc, char* argv[])
+{
+    using namespace RTBEngine::Tests;
+
+    bool benchmarks = false;
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench") == 0) {
+            benchmarks = true;
+        }
+        else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            // Option for the tests; keep it with its value
+            TestRegistry::GetArguments().push_back(argv[i]);
+            if (i + 1 < argc) TestRegistry::GetArguments().push_back(argv[++i]);
+        }
+        else if (filter.empty()) {
+            filter = argv[i];
+        }
+    }
+
+    int run = 0;
+    int failed = 0;
+    for (const TestCase& test : TestRegistry::GetCases()) {
+        if (test.isBenchmark != benchmarks) continue;
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos) continue;
+
+        std::printf("[ RUN  ] %s\n", test.name);
+        TestRegistry::GetFailureCount() = 0;
+        test.function();
+        run++;
+
+        if (TestRegistry::GetFailureCount() > 0) {
+            std::printf("[ FAIL ] %s\n", test.name);
+            failed++;
+        }
+        else {
+            std::printf("[  OK  ] %s\n", test.name);
+        }
+    }
+
+    std::printf("%d run, %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}